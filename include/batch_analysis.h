@@ -0,0 +1,283 @@
+#ifndef BATCH_ANALYSIS_H
+#define BATCH_ANALYSIS_H
+
+#include "data_loader.h"
+#include "integrated_social_network.h"
+#include "weighted_betweenness.h"
+#include "influence_oracle.h"
+#include "graph_profile.h"
+#include <vector>
+#include <string>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <filesystem>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <algorithm>
+#include <exception>
+
+using namespace std;
+
+// BATCH ANALYSIS
+
+struct BatchJob {
+    string path;
+    uintmax_t file_bytes;
+    size_t estimated_bytes;
+};
+
+/**
+* @var: num_threads: graphs analysed at once (0 = all cores)
+* @var: memory_budget_bytes: cap on the summed estimates of graphs in flight (0 = none)
+* @var: top_k: BC nodes and greedy seeds reported per graph
+* @var: num_recs: recommendations reported for the highest degree user
+*
+**/
+struct BatchOptions {
+    int num_threads = 0;
+    size_t memory_budget_bytes = 0;
+    int top_k = 5;
+    int num_recs = 5;
+    InfluenceOracleOptions oracle;
+};
+
+struct BatchSummary {
+    size_t succeeded = 0;
+    size_t failed = 0;
+    size_t peak_estimated_bytes = 0;
+};
+
+class BatchAnalysis {
+private:
+    // Rough peak per byte of edge list: Graph, BC workspaces and oracle sketches
+    static const size_t BYTES_PER_FILE_BYTE = 32;
+    static const size_t BYTES_PER_JOB = 1 << 20;
+
+    static string json_escape(const string& s) {
+        string out;
+        for (char c : s) {
+            if (c == '"' || c == '\\') out += '\\';
+            if ((unsigned char)c < 0x20) {
+                out += ' ';
+                continue;
+            }
+            out += c;
+        }
+        return out;
+    }
+
+    static string error_line(const string& path, const string& message) {
+        return "{\"file\":\"" + json_escape(path) + "\",\"error\":\"" + json_escape(message) + "\"}";
+    }
+
+    template <typename GraphT, typename Container>
+    static string json_ids(const GraphT& g, const Container& nodes) {
+        string out = "[";
+        bool first = true;
+        for (NodeID n : nodes) {
+            if (!first) out += ",";
+            out += to_string(g.original_id(n));
+            first = false;
+        }
+        return out + "]";
+    }
+
+public:
+    static size_t estimate_job_bytes(uintmax_t file_bytes) {
+        return BYTES_PER_JOB + (size_t)file_bytes * BYTES_PER_FILE_BYTE;
+    }
+
+    /**
+    *@brief: lists the edge files of a batch
+    *
+    *@param: path: a directory (every *.edges file in it) or a manifest with one
+    *              path per line; relative paths are taken from the manifest's folder
+    *@return: jobs largest first; files that cannot be found are kept with size 0
+    *         so they are reported as failures
+    *
+    **/
+    static vector<BatchJob> collect_jobs(const string& path) {
+        namespace fs = std::filesystem;
+        vector<BatchJob> jobs;
+        error_code ec;
+        vector<string> files;
+
+        if (fs::is_directory(path, ec)) {
+            for (const auto& entry : fs::directory_iterator(path, ec)) {
+                if (entry.is_regular_file() && entry.path().extension() == ".edges") {
+                    files.push_back(entry.path().string());
+                }
+            }
+        } else {
+            ifstream manifest(path);
+            fs::path base = fs::path(path).parent_path();
+            string line;
+            while (getline(manifest, line)) {
+                line.erase(0, line.find_first_not_of(" \t"));
+                line.erase(line.find_last_not_of(" \t\r") + 1);
+                if (line.empty() || line[0] == '#') continue;
+                fs::path p(line);
+                files.push_back(p.is_absolute() ? line : (base / p).string());
+            }
+        }
+
+        for (const auto& f : files) {
+            uintmax_t size = fs::file_size(f, ec);
+            if (ec) size = 0;
+            jobs.push_back({f, size, estimate_job_bytes(size)});
+        }
+        stable_sort(jobs.begin(), jobs.end(), [](const BatchJob& a, const BatchJob& b) {
+            return a.file_bytes != b.file_bytes ? a.file_bytes > b.file_bytes : a.path < b.path;
+        });
+        return jobs;
+    }
+
+    // Full per-graph report as one JSON object on a single line
+    template <typename GraphT>
+    static string analyze_graph(const GraphT& g, const BatchOptions& options) {
+        ostringstream out;
+        out << fixed << setprecision(4);
+        const auto& adj = g.get_adj_list();
+
+        // one thread per graph; the batch already runs graphs side by side
+        GraphProfileOptions profile_options;
+        profile_options.num_threads = 1;
+        out << GraphProfiler::profile(g, profile_options).json_fields();
+
+        size_t max_degree = 0;
+        NodeID hub = -1;
+        for (const auto& p : adj) {
+            size_t degree = g.get_neighbors(p.first).size();
+            if (hub == -1 || degree > max_degree) {
+                max_degree = degree;
+                hub = p.first;
+            }
+        }
+
+        WeightedBCOptions bc_options;
+        bc_options.quantum = 1.0;
+        auto bc_top = WeightedBetweennessCentrality::get_top_k_nodes(g, options.top_k, bc_options,
+                                                                     UnitDistance());
+        out << ",\"bc_top\":" << json_ids(g, bc_top);
+
+        InfluenceOracle oracle = InfluenceOracle::build(g, options.oracle);
+        auto seeds = oracle.greedy_seeds(options.top_k);
+        out << ",\"seeds\":" << json_ids(g, seeds)
+            << ",\"seed_spread\":" << oracle.estimate_spread(seeds);
+
+        vector<NodeID> recs;
+        if (hub != -1) {
+            for (const auto& rec : FriendRecommendation::get_recommendations(g, hub, options.num_recs)) {
+                recs.push_back(rec.candidate_id);
+            }
+        }
+        out << ",\"rec_user\":" << g.original_id(hub)
+            << ",\"recommendations\":" << json_ids(g, recs);
+        return out.str();
+    }
+
+    static string analyze_file(const BatchJob& job, const BatchOptions& options) {
+        const double DEFAULT_PROBABILITY = 0.01;
+        auto start = chrono::high_resolution_clock::now();
+        ifstream file(job.path);
+        if (!file.is_open()) return error_line(job.path, "could not open file");
+        Graph g;
+        read_edge_list(g, file, DEFAULT_PROBABILITY);
+        if (g.get_adj_list().empty()) return error_line(job.path, "graph is empty");
+
+        ostringstream line;
+        line << "{\"file\":\"" << json_escape(job.path) << "\",";
+        line << analyze_graph(g, options);
+        auto end = chrono::high_resolution_clock::now();
+        line << ",\"elapsed_ms\":" << chrono::duration_cast<chrono::milliseconds>(end - start).count()
+             << "}";
+        return line.str();
+    }
+
+    /**
+    *@brief: analyses every job on a pool of threads and writes one JSON line per graph
+    *
+    * Workers take the largest remaining job that fits in the memory budget next to
+    * the jobs already running; a job bigger than the whole budget runs alone.
+    * Lines are written in completion order.
+    *
+    **/
+    static BatchSummary run(const vector<BatchJob>& jobs, const BatchOptions& options,
+                            ostream& out, ostream* progress = nullptr) {
+        BatchSummary summary;
+        int num_threads = options.num_threads;
+        if (num_threads <= 0) num_threads = max(1u, thread::hardware_concurrency());
+        num_threads = (int)min<size_t>(num_threads, max<size_t>(1, jobs.size()));
+
+        mutex m;
+        condition_variable cv;
+        vector<char> taken(jobs.size(), 0);
+        size_t remaining = jobs.size();
+        size_t in_flight_jobs = 0;
+        size_t in_flight_bytes = 0;
+
+        auto worker = [&]() {
+            while (true) {
+                size_t pick = jobs.size();
+                {
+                    unique_lock<mutex> lock(m);
+                    cv.wait(lock, [&]() {
+                        if (remaining == 0) return true;
+                        for (size_t i = 0; i < jobs.size(); ++i) {
+                            if (taken[i]) continue;
+                            bool fits = options.memory_budget_bytes == 0 ||
+                                        in_flight_bytes + jobs[i].estimated_bytes <= options.memory_budget_bytes;
+                            if (fits || in_flight_jobs == 0) {
+                                pick = i;
+                                return true;
+                            }
+                        }
+                        return false;
+                    });
+                    if (remaining == 0) return;
+                    taken[pick] = 1;
+                    remaining--;
+                    in_flight_jobs++;
+                    in_flight_bytes += jobs[pick].estimated_bytes;
+                    summary.peak_estimated_bytes = max(summary.peak_estimated_bytes, in_flight_bytes);
+                }
+
+                // one graph running out of memory or failing must not take the batch down
+                string line;
+                try {
+                    line = analyze_file(jobs[pick], options);
+                } catch (const exception& e) {
+                    line = error_line(jobs[pick].path, e.what());
+                } catch (...) {
+                    line = error_line(jobs[pick].path, "unknown error");
+                }
+                bool failed = line.find("\"error\":") != string::npos;
+
+                {
+                    lock_guard<mutex> lock(m);
+                    out << line << "\n";
+                    out.flush();
+                    if (failed) summary.failed++;
+                    else summary.succeeded++;
+                    if (progress) {
+                        *progress << "[" << (summary.succeeded + summary.failed) << "/" << jobs.size()
+                                  << "] " << jobs[pick].path << (failed ? " (failed)" : "") << endl;
+                    }
+                    in_flight_jobs--;
+                    in_flight_bytes -= jobs[pick].estimated_bytes;
+                }
+                cv.notify_all();
+            }
+        };
+
+        vector<thread> threads;
+        for (int t = 0; t < num_threads; ++t) threads.emplace_back(worker);
+        for (auto& th : threads) th.join();
+        return summary;
+    }
+};
+
+#endif
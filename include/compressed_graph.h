@@ -0,0 +1,485 @@
+#ifndef COMPRESSED_GRAPH_H
+#define COMPRESSED_GRAPH_H
+
+#include "data_loader.h"
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <istream>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#endif
+
+using namespace std;
+
+// COMPRESSED GRAPH
+
+/**
+* @brief: Stream-VByte codec used for the neighbour lists
+*
+* Values are written in groups of four: one control byte holding four 2-bit
+* lengths (1-4 bytes each) followed by the little-endian data bytes. Lists are
+* padded with zeros to whole groups so every group can be decoded the same way.
+*
+**/
+class StreamVByte {
+private:
+    struct Tables {
+        uint8_t length[256];
+        uint8_t shuffle[256][16];
+
+        Tables() {
+            for (int c = 0; c < 256; ++c) {
+                int out = 0, in = 0;
+                for (int lane = 0; lane < 4; ++lane) {
+                    int len = ((c >> (2 * lane)) & 3) + 1;
+                    for (int b = 0; b < 4; ++b) {
+                        shuffle[c][out++] = (b < len) ? (uint8_t)(in + b) : 0xFF;
+                    }
+                    in += len;
+                }
+                length[c] = (uint8_t)in;
+            }
+        }
+    };
+
+    static const Tables& tables() {
+        static const Tables t;
+        return t;
+    }
+
+public:
+    static int value_length(uint32_t v) {
+        if (v < (1u << 8)) return 1;
+        if (v < (1u << 16)) return 2;
+        if (v < (1u << 24)) return 3;
+        return 4;
+    }
+
+    static void encode_group(const uint32_t values[4], vector<uint8_t>& out) {
+        uint8_t control = 0;
+        for (int lane = 0; lane < 4; ++lane) {
+            control |= (uint8_t)((value_length(values[lane]) - 1) << (2 * lane));
+        }
+        out.push_back(control);
+        for (int lane = 0; lane < 4; ++lane) {
+            uint32_t v = values[lane];
+            for (int b = 0; b < value_length(values[lane]); ++b) {
+                out.push_back((uint8_t)(v & 0xFF));
+                v >>= 8;
+            }
+        }
+    }
+
+    /**
+    *@brief: decodes one group of deltas and turns them into absolute values
+    *
+    *@param: in: control byte followed by the data bytes; 16 bytes must be readable
+    *@param: prev: last absolute value of the previous group
+    *@return: number of bytes consumed
+    *
+    **/
+    static int decode_group(const uint8_t* in, uint32_t prev, uint32_t out[4]) {
+#if defined(__SSSE3__)
+        uint8_t control = in[0];
+        const uint8_t* data = in + 1;
+        __m128i bytes = _mm_loadu_si128((const __m128i*)data);
+        __m128i mask = _mm_loadu_si128((const __m128i*)tables().shuffle[control]);
+        __m128i v = _mm_shuffle_epi8(bytes, mask);
+        v = _mm_add_epi32(v, _mm_slli_si128(v, 4));
+        v = _mm_add_epi32(v, _mm_slli_si128(v, 8));
+        v = _mm_add_epi32(v, _mm_set1_epi32((int)prev));
+        _mm_storeu_si128((__m128i*)out, v);
+        return 1 + tables().length[control];
+#else
+        return decode_group_scalar(in, prev, out);
+#endif
+    }
+
+    // Portable decoder; decode_group() uses it when built without SSSE3
+    static int decode_group_scalar(const uint8_t* in, uint32_t prev, uint32_t out[4]) {
+        uint8_t control = in[0];
+        const uint8_t* data = in + 1;
+        for (int lane = 0; lane < 4; ++lane) {
+            int len = ((control >> (2 * lane)) & 3) + 1;
+            uint32_t v = 0;
+            for (int b = 0; b < len; ++b) v |= (uint32_t)data[b] << (8 * b);
+            data += len;
+            prev += v;
+            out[lane] = prev;
+        }
+        return 1 + tables().length[control];
+    }
+
+    static bool uses_simd() {
+#if defined(__SSSE3__)
+        return true;
+#else
+        return false;
+#endif
+    }
+};
+
+/**
+* @brief: Read-only graph with gap-encoded neighbour lists
+*
+* Exposes the same get_adj_list()/get_neighbors() iteration as Graph, so the
+* templated algorithms in integrated_social_network.h run on it unchanged.
+* Neighbour lists are sorted, stored as gaps between dense node indices and
+* packed with Stream-VByte. Probabilities are kept as 8-bit values, or dropped
+* entirely when every edge shares one (as with the file loader's default).
+* Influence probabilities used by ICM are derived from common neighbours on
+* demand and need no storage at all.
+*
+**/
+class CompressedGraph {
+private:
+    vector<NodeID> ids;                 // sorted node IDs, dense index -> ID
+    vector<uint64_t> byte_offsets;      // per node start in data, size n + 1
+    vector<uint64_t> edge_offsets;      // per node start in probabilities, size n + 1
+    vector<uint8_t> data;
+    vector<uint8_t> probabilities;      // empty when uniform
+    double uniform_probability = 0.0;
+    vector<NodeID> original_ids;
+    vector<pair<NodeID, NodeID>> by_original;   // (original ID, node) sorted
+    bool dense_ids = false;             // ids[i] == i, as after relabeling
+
+    static const int PADDING = 16;
+
+    long long index_of(NodeID node) const {
+        if (dense_ids) {
+            return (node >= 0 && (size_t)node < ids.size()) ? node : -1;
+        }
+        auto it = lower_bound(ids.begin(), ids.end(), node);
+        if (it == ids.end() || *it != node) return -1;
+        return it - ids.begin();
+    }
+
+    CompressedGraph() {}
+
+    // Entries of a sorted list whose target is at or above node
+    static long long end_count_from(const uint32_t* begin, const uint32_t* end, size_t node) {
+        return end - lower_bound(begin, end, (uint32_t)node);
+    }
+
+    // Gap-encodes one node's sorted dense neighbour indices and closes its offsets
+    void append_list(const uint32_t* targets, size_t count) {
+        uint32_t group[4];
+        uint32_t prev = 0;
+        for (size_t i = 0; i < count; i += 4) {
+            for (size_t lane = 0; lane < 4; ++lane) {
+                if (i + lane < count) {
+                    group[lane] = targets[i + lane] - prev;
+                    prev = targets[i + lane];
+                } else {
+                    group[lane] = 0;
+                }
+            }
+            StreamVByte::encode_group(group, data);
+        }
+        byte_offsets.push_back(data.size());
+        edge_offsets.push_back(edge_offsets.back() + count);
+    }
+
+    void finish_encoding() {
+        // the SIMD decoder always loads 16 bytes past the control byte
+        data.insert(data.end(), PADDING, 0);
+        data.shrink_to_fit();
+        probabilities.shrink_to_fit();
+    }
+
+public:
+    class NeighborIterator {
+    private:
+        const CompressedGraph* g = nullptr;
+        const uint8_t* in = nullptr;
+        uint64_t edge = 0;
+        uint64_t remaining = 0;
+        uint32_t block[4];
+        int pos = 4;
+
+    public:
+        NeighborIterator() {}
+        NeighborIterator(const CompressedGraph* graph, const uint8_t* start,
+                         uint64_t first_edge, uint64_t count)
+            : g(graph), in(start), edge(first_edge), remaining(count) {
+            if (remaining > 0) {
+                in += StreamVByte::decode_group(in, 0, block);
+                pos = 0;
+            }
+        }
+
+        InfluenceEdge operator*() const {
+            return {g->ids[block[pos]], g->probability_at(edge)};
+        }
+
+        NeighborIterator& operator++() {
+            --remaining;
+            ++edge;
+            if (++pos == 4 && remaining > 0) {
+                in += StreamVByte::decode_group(in, block[3], block);
+                pos = 0;
+            }
+            return *this;
+        }
+
+        bool operator==(const NeighborIterator& other) const { return remaining == other.remaining; }
+        bool operator!=(const NeighborIterator& other) const { return remaining != other.remaining; }
+    };
+
+    class NeighborRange {
+    private:
+        const CompressedGraph* g;
+        long long node;
+
+    public:
+        NeighborRange(const CompressedGraph* graph, long long index) : g(graph), node(index) {}
+
+        size_t size() const {
+            return node < 0 ? 0 : g->edge_offsets[node + 1] - g->edge_offsets[node];
+        }
+        bool empty() const { return size() == 0; }
+
+        NeighborIterator begin() const {
+            if (node < 0) return NeighborIterator();
+            return NeighborIterator(g, g->data.data() + g->byte_offsets[node],
+                                    g->edge_offsets[node], size());
+        }
+        NeighborIterator end() const { return NeighborIterator(); }
+    };
+
+    class NodeIterator {
+    private:
+        const CompressedGraph* g;
+        size_t index;
+
+    public:
+        NodeIterator(const CompressedGraph* graph, size_t i) : g(graph), index(i) {}
+
+        pair<NodeID, NeighborRange> operator*() const {
+            return {g->ids[index], NeighborRange(g, index)};
+        }
+
+        struct ArrowProxy {
+            pair<NodeID, NeighborRange> value;
+            const pair<NodeID, NeighborRange>* operator->() const { return &value; }
+        };
+        ArrowProxy operator->() const { return {**this}; }
+        NodeIterator& operator++() { ++index; return *this; }
+        bool operator==(const NodeIterator& other) const { return index == other.index; }
+        bool operator!=(const NodeIterator& other) const { return index != other.index; }
+    };
+
+    class NodeRange {
+    private:
+        const CompressedGraph* g;
+
+    public:
+        explicit NodeRange(const CompressedGraph* graph) : g(graph) {}
+
+        NodeIterator begin() const { return NodeIterator(g, 0); }
+        NodeIterator end() const { return NodeIterator(g, g->ids.size()); }
+        size_t size() const { return g->ids.size(); }
+        bool empty() const { return g->ids.empty(); }
+        size_t count(NodeID node) const { return g->index_of(node) >= 0 ? 1 : 0; }
+    };
+
+    explicit CompressedGraph(const Graph& g) {
+        const auto& adj = g.get_adj_list();
+        size_t n = adj.size();
+        ids.reserve(n);
+        for (const auto& p : adj) ids.push_back(p.first);
+        dense_ids = n == 0 || (ids.front() == 0 && ids.back() == (NodeID)(n - 1));
+
+        bool uniform = true;
+        bool first = true;
+        for (const auto& p : adj) {
+            for (const auto& edge : p.second) {
+                if (first) {
+                    uniform_probability = edge.probability;
+                    first = false;
+                } else if (edge.probability != uniform_probability) {
+                    uniform = false;
+                }
+            }
+        }
+
+        byte_offsets.reserve(n + 1);
+        edge_offsets.reserve(n + 1);
+        byte_offsets.push_back(0);
+        edge_offsets.push_back(0);
+
+        vector<pair<uint32_t, double>> list;
+        vector<uint32_t> targets;
+        for (const auto& p : adj) {
+            list.clear();
+            for (const auto& edge : p.second) {
+                list.push_back({(uint32_t)index_of(edge.target), edge.probability});
+            }
+            sort(list.begin(), list.end());
+
+            targets.clear();
+            for (const auto& t : list) targets.push_back(t.first);
+            append_list(targets.data(), targets.size());
+            if (!uniform) {
+                for (const auto& t : list) {
+                    probabilities.push_back((uint8_t)lround(min(1.0, max(0.0, t.second)) * 255.0));
+                }
+            }
+        }
+        finish_encoding();
+
+        if (g.is_relabeled()) {
+            original_ids.reserve(n);
+            by_original.reserve(n);
+            for (NodeID id : ids) {
+                original_ids.push_back(g.original_id(id));
+                by_original.push_back({original_ids.back(), id});
+            }
+            sort(by_original.begin(), by_original.end());
+        }
+    }
+
+    /**
+    *@brief: builds the compressed graph straight from an edge list, never creating a Graph
+    *
+    * Two passes over a seekable stream: the first collects node IDs and degree
+    * bounds, the second fills a flat 32-bit CSR that is then sorted, de-duplicated
+    * and encoded node by node. Peak memory is the ID table plus 8 bytes per input
+    * line on top of the result, against a map node per vertex and 16 bytes per
+    * entry for Graph. Edges follow read_edge_list(): every edge gets probability,
+    * duplicates in either direction are skipped and a self loop is stored once.
+    *
+    *@return: the graph; edge_count and duplicates receive the same counts read_edge_list() reports
+    *
+    **/
+    static CompressedGraph build_from_edge_list(istream& in, double probability,
+                                                long long* edge_count = nullptr,
+                                                long long* duplicates = nullptr) {
+        CompressedGraph c;
+        string line;
+        unordered_map<NodeID, uint32_t> degree_bound;
+        streampos start = in.tellg();
+
+        while (getline(in, line)) {
+            stringstream ss(line);
+            NodeID u, v;
+            if (ss >> u >> v) {
+                degree_bound[u]++;
+                if (u != v) degree_bound[v]++;
+            }
+        }
+
+        size_t n = degree_bound.size();
+        c.ids.reserve(n);
+        for (const auto& d : degree_bound) c.ids.push_back(d.first);
+        sort(c.ids.begin(), c.ids.end());
+        c.dense_ids = n == 0 || (c.ids.front() == 0 && c.ids.back() == (NodeID)(n - 1));
+
+        vector<uint64_t> fill(n + 1, 0);
+        for (size_t i = 0; i < n; ++i) fill[i + 1] = fill[i] + degree_bound[c.ids[i]];
+        degree_bound = unordered_map<NodeID, uint32_t>();
+        vector<uint32_t> flat(fill[n]);
+        vector<uint64_t> bounds(fill);
+
+        in.clear();
+        in.seekg(start);
+        while (getline(in, line)) {
+            stringstream ss(line);
+            NodeID u, v;
+            if (ss >> u >> v) {
+                uint32_t iu = c.index_of(u), iv = c.index_of(v);
+                flat[fill[iu]++] = iv;
+                if (u != v) flat[fill[iv]++] = iu;
+            }
+        }
+
+        long long edges = 0, skipped = 0;
+        c.byte_offsets.reserve(n + 1);
+        c.edge_offsets.reserve(n + 1);
+        c.byte_offsets.push_back(0);
+        c.edge_offsets.push_back(0);
+        for (size_t i = 0; i < n; ++i) {
+            uint32_t* begin = flat.data() + bounds[i];
+            uint32_t* end = flat.data() + bounds[i + 1];
+            sort(begin, end);
+            // each input line is counted once, from its lower endpoint
+            long long lines = end_count_from(begin, end, i);
+            uint32_t* last = unique(begin, end);
+            edges += end_count_from(begin, last, i);
+            skipped += lines - end_count_from(begin, last, i);
+            c.append_list(begin, last - begin);
+        }
+        c.uniform_probability = probability;
+        c.finish_encoding();
+
+        if (edge_count) *edge_count = edges;
+        if (duplicates) *duplicates = skipped;
+        return c;
+    }
+
+    NodeRange get_adj_list() const {
+        return NodeRange(this);
+    }
+
+    NeighborRange get_neighbors(NodeID node) const {
+        return NeighborRange(this, index_of(node));
+    }
+
+    // Decodes the shorter of the two sorted lists, stopping once it passes the other end
+    bool has_edge(NodeID u, NodeID v) const {
+        NeighborRange nu = get_neighbors(u), nv = get_neighbors(v);
+        if (nu.empty() || nv.empty()) return false;
+        bool u_shorter = nu.size() <= nv.size();
+        NodeID other = u_shorter ? v : u;
+        for (const auto& edge : u_shorter ? nu : nv) {
+            if (edge.target >= other) return edge.target == other;
+        }
+        return false;
+    }
+
+    double probability_at(uint64_t edge) const {
+        if (probabilities.empty()) return uniform_probability;
+        return probabilities[edge] / 255.0;
+    }
+
+    bool is_relabeled() const {
+        return !original_ids.empty();
+    }
+
+    NodeID original_id(NodeID node) const {
+        if (original_ids.empty()) return node;
+        long long i = index_of(node);
+        return i >= 0 ? original_ids[i] : -1;
+    }
+
+    NodeID internal_id(NodeID original) const {
+        if (original_ids.empty()) return original;
+        auto it = lower_bound(by_original.begin(), by_original.end(),
+                              make_pair(original, (NodeID)-1));
+        return (it != by_original.end() && it->first == original) ? it->second : -1;
+    }
+
+    size_t num_edges() const {
+        return edge_offsets.back();
+    }
+
+    size_t memory_bytes() const {
+        return sizeof(*this) +
+               ids.capacity() * sizeof(NodeID) +
+               byte_offsets.capacity() * sizeof(uint64_t) +
+               edge_offsets.capacity() * sizeof(uint64_t) +
+               data.capacity() + probabilities.capacity() +
+               original_ids.capacity() * sizeof(NodeID) +
+               by_original.capacity() * sizeof(pair<NodeID, NodeID>);
+    }
+};
+
+#endif
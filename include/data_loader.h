@@ -3,6 +3,11 @@
 
 #include <vector>
 #include <map>
+#include <unordered_map>
+#include <cstddef>
+#include <istream>
+#include <sstream>
+#include <string>
 
 using NodeID = int;
 
@@ -14,11 +19,49 @@ struct InfluenceEdge {
 class Graph {
 private:
     std::map<NodeID, std::vector<InfluenceEdge>> adj;
+    // Set when the graph was relabeled; empty means IDs are the original ones
+    std::vector<NodeID> original_ids;
+    std::unordered_map<NodeID, NodeID> internal_ids;
+
+    void erase_target(NodeID node, NodeID target) {
+        auto it = adj.find(node);
+        auto& list = it->second;
+        for (std::size_t i = 0; i < list.size(); ++i) {
+            if (list[i].target == target) {
+                list.erase(list.begin() + i);
+                break;
+            }
+        }
+        if (list.empty()) adj.erase(it);
+    }
 
 public:
-    void add_edge(NodeID u, NodeID v, double probability) {
+    // Returns false and leaves the graph unchanged if the edge already exists
+    bool add_edge(NodeID u, NodeID v, double probability) {
+        if (has_edge(u, v)) return false;
         adj[u].push_back({v, probability});
-        adj[v].push_back({u, probability});
+        if (u != v) adj[v].push_back({u, probability});
+        return true;
+    }
+
+    bool has_edge(NodeID u, NodeID v) const {
+        auto iu = adj.find(u), iv = adj.find(v);
+        if (iu == adj.end() || iv == adj.end()) return false;
+        // scan the shorter list
+        const auto& list = iu->second.size() <= iv->second.size() ? iu->second : iv->second;
+        NodeID other = iu->second.size() <= iv->second.size() ? v : u;
+        for (const auto& edge : list) {
+            if (edge.target == other) return true;
+        }
+        return false;
+    }
+
+    // Nodes left without neighbours are dropped, as if they were never added
+    bool remove_edge(NodeID u, NodeID v) {
+        if (!has_edge(u, v)) return false;
+        erase_target(u, v);
+        if (u != v) erase_target(v, u);
+        return true;
     }
 
     const std::map<NodeID, std::vector<InfluenceEdge>>& get_adj_list() const {
@@ -33,6 +76,55 @@ public:
         static const std::vector<InfluenceEdge> empty_vec;
         return empty_vec;
     }
+
+    // original_ids[i] is the ID node i had in the input file
+    void set_original_ids(const std::vector<NodeID>& ids) {
+        original_ids = ids;
+        internal_ids.clear();
+        for (std::size_t i = 0; i < ids.size(); ++i) {
+            internal_ids[ids[i]] = (NodeID)i;
+        }
+    }
+
+    bool is_relabeled() const {
+        return !original_ids.empty();
+    }
+
+    NodeID original_id(NodeID node) const {
+        if (original_ids.empty()) return node;
+        if (node < 0 || (std::size_t)node >= original_ids.size()) return -1;
+        return original_ids[node];
+    }
+
+    // Returns -1 for IDs that are not part of a relabeled graph
+    NodeID internal_id(NodeID original) const {
+        if (original_ids.empty()) return original;
+        auto it = internal_ids.find(original);
+        return it != internal_ids.end() ? it->second : -1;
+    }
 };
 
+// Reads "u v" pairs, one per line; returns the number of distinct edges added
+inline long long read_edge_list(Graph& g, std::istream& in, double probability,
+                                long long* duplicates = nullptr) {
+    std::string line;
+    long long edge_count = 0;
+    long long duplicate_count = 0;
+
+    while (std::getline(in, line)) {
+        std::stringstream ss(line);
+        NodeID u, v;
+        if (ss >> u >> v) {
+            if (g.add_edge(u, v, probability)) {
+                edge_count++;
+            } else {
+                duplicate_count++;
+            }
+        }
+    }
+
+    if (duplicates) *duplicates = duplicate_count;
+    return edge_count;
+}
+
 #endif
@@ -0,0 +1,368 @@
+#ifndef GRAPH_PROFILE_H
+#define GRAPH_PROFILE_H
+
+#include "data_loader.h"
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <string>
+#include <sstream>
+#include <iomanip>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+
+using namespace std;
+
+// GRAPH PROFILE
+
+/**
+* @var: max_diameter_bfs: BFS runs the diameter search may spend; when it runs
+*                         out the diameter is reported as [lower, upper] bounds
+*
+**/
+struct GraphProfileOptions {
+    int num_threads = 0;
+    int max_diameter_bfs = 64;
+};
+
+/**
+* @brief: Size and shape of a graph, enough to predict what BC and ICM will cost
+*
+* @var: degree_p50 / p90 / p99: nearest-rank degree percentiles
+* @var: global_clustering: 3 * triangles / connected triples
+* @var: average_clustering: mean local coefficient, nodes of degree < 2 count as 0
+* @var: diameter_lower / upper: bounds for the largest component, equal when exact
+*
+**/
+struct GraphProfile {
+    long long num_nodes = 0;
+    long long num_edges = 0;
+    size_t min_degree = 0;
+    size_t max_degree = 0;
+    size_t degree_p50 = 0;
+    size_t degree_p90 = 0;
+    size_t degree_p99 = 0;
+    map<size_t, long long> degree_histogram;   // degree -> number of nodes
+
+    long long num_components = 0;
+    long long largest_component_nodes = 0;
+
+    long long triangles = 0;
+    double global_clustering = 0.0;
+    double average_clustering = 0.0;
+
+    int diameter_lower = 0;
+    int diameter_upper = 0;
+    int diameter_bfs_count = 0;
+
+    double average_degree() const {
+        return num_nodes > 0 ? 2.0 * num_edges / num_nodes : 0.0;
+    }
+
+    bool diameter_exact() const {
+        return diameter_lower == diameter_upper;
+    }
+
+    // Comma-separated "key":value pairs, so callers can embed them in their own objects
+    string json_fields() const {
+        ostringstream out;
+        out << fixed << setprecision(4);
+        out << "\"nodes\":" << num_nodes << ",\"edges\":" << num_edges
+            << ",\"avg_degree\":" << average_degree() << ",\"max_degree\":" << max_degree
+            << ",\"min_degree\":" << min_degree
+            << ",\"degree_p50\":" << degree_p50 << ",\"degree_p90\":" << degree_p90
+            << ",\"degree_p99\":" << degree_p99 << ",\"degree_histogram\":{";
+        bool first = true;
+        for (const auto& h : degree_histogram) {
+            if (!first) out << ",";
+            out << "\"" << h.first << "\":" << h.second;
+            first = false;
+        }
+        out << "},\"components\":" << num_components
+            << ",\"largest_component\":" << largest_component_nodes
+            << ",\"triangles\":" << triangles
+            << ",\"global_clustering\":" << global_clustering
+            << ",\"average_clustering\":" << average_clustering
+            << ",\"diameter_lower\":" << diameter_lower << ",\"diameter_upper\":" << diameter_upper;
+        return out.str();
+    }
+
+    string to_json() const {
+        return "{" + json_fields() + "}";
+    }
+};
+
+class GraphProfiler {
+private:
+    // Dense CSR, neighbour lists sorted by index
+    struct DenseGraph {
+        vector<NodeID> ids;
+        vector<size_t> offsets;
+        vector<int> targets;
+
+        int size() const { return ids.size(); }
+        size_t degree(int u) const { return offsets[u + 1] - offsets[u]; }
+    };
+
+    template <typename GraphT>
+    static DenseGraph make_dense(const GraphT& g) {
+        DenseGraph d;
+        unordered_map<NodeID, int> index;
+        for (const auto& p : g.get_adj_list()) {
+            index[p.first] = d.ids.size();
+            d.ids.push_back(p.first);
+        }
+        d.offsets.push_back(0);
+        for (NodeID u : d.ids) {
+            size_t begin = d.targets.size();
+            for (const auto& edge : g.get_neighbors(u)) d.targets.push_back(index[edge.target]);
+            sort(d.targets.begin() + begin, d.targets.end());
+            d.offsets.push_back(d.targets.size());
+        }
+        return d;
+    }
+
+    template <typename Fn>
+    static void parallel_for(int num_threads, size_t count, const Fn& fn) {
+        auto worker = [&](int t) {
+            for (size_t i = t; i < count; i += num_threads) fn(t, i);
+        };
+        vector<thread> threads;
+        for (int t = 1; t < num_threads; ++t) threads.emplace_back(worker, t);
+        worker(0);
+        for (auto& th : threads) th.join();
+    }
+
+    // Lock-free union-find; roots always link to the smaller index
+    static int find_root(vector<atomic<int>>& parent, int x) {
+        while (true) {
+            int p = parent[x].load(memory_order_relaxed);
+            if (p == x) return x;
+            int gp = parent[p].load(memory_order_relaxed);
+            if (gp != p) parent[x].compare_exchange_weak(p, gp, memory_order_relaxed);
+            x = gp;
+        }
+    }
+
+    static void unite(vector<atomic<int>>& parent, int a, int b) {
+        while (true) {
+            a = find_root(parent, a);
+            b = find_root(parent, b);
+            if (a == b) return;
+            if (a < b) swap(a, b);
+            int expected = a;
+            if (parent[a].compare_exchange_strong(expected, b, memory_order_relaxed)) return;
+        }
+    }
+
+    // BFS buffers for one thread; dist is reset through the visit order
+    struct BFSWorkspace {
+        vector<int> dist;
+        vector<int> parent;
+        vector<int> order;
+
+        explicit BFSWorkspace(int n) : dist(n, -1), parent(n, -1) {}
+    };
+
+    // Eccentricity of source; ws.order holds the component in BFS order afterwards
+    static int bfs(const DenseGraph& d, int source, BFSWorkspace& ws) {
+        for (int v : ws.order) ws.dist[v] = -1;
+        ws.order.clear();
+        ws.order.push_back(source);
+        ws.dist[source] = 0;
+        ws.parent[source] = -1;
+        for (size_t head = 0; head < ws.order.size(); ++head) {
+            int u = ws.order[head];
+            for (size_t e = d.offsets[u]; e < d.offsets[u + 1]; ++e) {
+                int v = d.targets[e];
+                if (ws.dist[v] == -1) {
+                    ws.dist[v] = ws.dist[u] + 1;
+                    ws.parent[v] = u;
+                    ws.order.push_back(v);
+                }
+            }
+        }
+        return ws.dist[ws.order.back()];
+    }
+
+    static void profile_degrees(const DenseGraph& d, GraphProfile& profile) {
+        vector<size_t> degrees(d.size());
+        for (int u = 0; u < d.size(); ++u) {
+            degrees[u] = d.degree(u);
+            profile.degree_histogram[degrees[u]]++;
+        }
+        profile.num_edges = d.targets.size() / 2;
+        if (degrees.empty()) return;
+
+        sort(degrees.begin(), degrees.end());
+        auto percentile = [&](int p) {
+            size_t rank = (degrees.size() * p + 99) / 100;
+            return degrees[max<size_t>(rank, 1) - 1];
+        };
+        profile.min_degree = degrees.front();
+        profile.max_degree = degrees.back();
+        profile.degree_p50 = percentile(50);
+        profile.degree_p90 = percentile(90);
+        profile.degree_p99 = percentile(99);
+    }
+
+    static vector<int> profile_components(const DenseGraph& d, int num_threads, GraphProfile& profile) {
+        int n = d.size();
+        vector<atomic<int>> parent(n);
+        for (int u = 0; u < n; ++u) parent[u].store(u, memory_order_relaxed);
+
+        parallel_for(num_threads, n, [&](int, size_t u) {
+            for (size_t e = d.offsets[u]; e < d.offsets[u + 1]; ++e) {
+                if ((int)u < d.targets[e]) unite(parent, u, d.targets[e]);
+            }
+        });
+
+        vector<int> component(n);
+        vector<long long> sizes(n, 0);
+        for (int u = 0; u < n; ++u) {
+            component[u] = find_root(parent, u);
+            if (sizes[component[u]]++ == 0) profile.num_components++;
+            profile.largest_component_nodes = max(profile.largest_component_nodes, sizes[component[u]]);
+        }
+        return component;
+    }
+
+    // Each triangle is found once from its lowest-ranked corner, ranking by (degree, index)
+    static void profile_triangles(const DenseGraph& d, int num_threads, GraphProfile& profile) {
+        int n = d.size();
+        auto before = [&](int a, int b) {
+            return d.degree(a) != d.degree(b) ? d.degree(a) < d.degree(b) : a < b;
+        };
+
+        vector<size_t> fwd_offsets(n + 1, 0);
+        for (int u = 0; u < n; ++u) {
+            size_t count = 0;
+            for (size_t e = d.offsets[u]; e < d.offsets[u + 1]; ++e) count += before(u, d.targets[e]);
+            fwd_offsets[u + 1] = fwd_offsets[u] + count;
+        }
+        vector<int> fwd(fwd_offsets[n]);
+        for (int u = 0; u < n; ++u) {
+            size_t pos = fwd_offsets[u];
+            for (size_t e = d.offsets[u]; e < d.offsets[u + 1]; ++e) {
+                if (before(u, d.targets[e])) fwd[pos++] = d.targets[e];
+            }
+        }
+
+        vector<atomic<long long>> per_node(n);
+        for (int u = 0; u < n; ++u) per_node[u].store(0, memory_order_relaxed);
+        vector<long long> partial(num_threads, 0);
+
+        parallel_for(num_threads, n, [&](int t, size_t u) {
+            for (size_t e = fwd_offsets[u]; e < fwd_offsets[u + 1]; ++e) {
+                int v = fwd[e];
+                size_t i = fwd_offsets[u], j = fwd_offsets[v];
+                while (i < fwd_offsets[u + 1] && j < fwd_offsets[v + 1]) {
+                    if (fwd[i] < fwd[j]) ++i;
+                    else if (fwd[i] > fwd[j]) ++j;
+                    else {
+                        partial[t]++;
+                        per_node[u].fetch_add(1, memory_order_relaxed);
+                        per_node[v].fetch_add(1, memory_order_relaxed);
+                        per_node[fwd[i]].fetch_add(1, memory_order_relaxed);
+                        ++i;
+                        ++j;
+                    }
+                }
+            }
+        });
+
+        for (long long c : partial) profile.triangles += c;
+        double triples = 0.0, local_sum = 0.0;
+        for (int u = 0; u < n; ++u) {
+            double k = d.degree(u);
+            if (k < 2) continue;
+            double pairs = k * (k - 1) / 2.0;
+            triples += pairs;
+            local_sum += per_node[u].load(memory_order_relaxed) / pairs;
+        }
+        if (triples > 0) profile.global_clustering = 3.0 * profile.triangles / triples;
+        if (n > 0) profile.average_clustering = local_sum / n;
+    }
+
+    // Double sweep for a lower bound, then iFUB from the middle of the long path:
+    // once every node at level >= i around the root has a known eccentricity, no
+    // pair below level i can be further apart than 2 (i - 1)
+    static void profile_diameter(const DenseGraph& d, const vector<int>& component, int num_threads,
+                                 const GraphProfileOptions& options, GraphProfile& profile) {
+        int n = d.size();
+        if (n == 0) return;
+
+        vector<long long> sizes(n, 0);
+        for (int u = 0; u < n; ++u) sizes[component[u]]++;
+        int start = -1;
+        for (int u = 0; u < n; ++u) {
+            if (sizes[component[u]] != profile.largest_component_nodes) continue;
+            if (start == -1 || d.degree(u) > d.degree(start)) start = u;
+        }
+
+        BFSWorkspace ws(n);
+        int& bfs_count = profile.diameter_bfs_count;
+        bfs(d, start, ws);
+        int a = ws.order.back();
+        int lower = bfs(d, a, ws);
+        bfs_count = 2;
+
+        int root = ws.order.back();
+        for (int step = 0; step < lower / 2; ++step) root = ws.parent[root];
+        int root_ecc = bfs(d, root, ws);
+        bfs_count++;
+        lower = max(lower, root_ecc);
+        int upper = 2 * root_ecc;
+
+        vector<vector<int>> levels(root_ecc + 1);
+        for (int v : ws.order) levels[ws.dist[v]].push_back(v);
+
+        int budget = max(options.max_diameter_bfs, bfs_count);
+        vector<BFSWorkspace> workspaces;
+        for (int level = root_ecc; level > 0 && upper > lower; --level) {
+            const auto& fringe = levels[level];
+            if (bfs_count + (int)fringe.size() > budget) break;
+            int threads = (int)min<size_t>(num_threads, fringe.size());
+            while ((int)workspaces.size() < threads) workspaces.emplace_back(n);
+
+            vector<int> best(threads, 0);
+            parallel_for(threads, fringe.size(), [&](int t, size_t i) {
+                best[t] = max(best[t], bfs(d, fringe[i], workspaces[t]));
+            });
+            bfs_count += fringe.size();
+            for (int b : best) lower = max(lower, b);
+            upper = max(lower, 2 * (level - 1));
+        }
+
+        profile.diameter_lower = lower;
+        profile.diameter_upper = max(lower, upper);
+    }
+
+public:
+    /**
+    *@brief: components, degree distribution, clustering and diameter in one pass
+    *
+    *@return: the profile; union-find and BFS are linear, triangle counting is
+    *         O(m sqrt(m)) worst case and usually close to linear on social graphs
+    *
+    **/
+    template <typename GraphT>
+    static GraphProfile profile(const GraphT& g, const GraphProfileOptions& options = GraphProfileOptions()) {
+        GraphProfile result;
+        DenseGraph d = make_dense(g);
+        result.num_nodes = d.size();
+
+        int num_threads = options.num_threads;
+        if (num_threads <= 0) num_threads = max(1u, thread::hardware_concurrency());
+        num_threads = (int)min<size_t>(num_threads, max(1, d.size()));
+
+        profile_degrees(d, result);
+        vector<int> component = profile_components(d, num_threads, result);
+        profile_triangles(d, num_threads, result);
+        profile_diameter(d, component, num_threads, options, result);
+        return result;
+    }
+};
+
+#endif
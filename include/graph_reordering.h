@@ -0,0 +1,307 @@
+#ifndef GRAPH_REORDERING_H
+#define GRAPH_REORDERING_H
+
+#include "data_loader.h"
+#include <vector>
+#include <unordered_map>
+#include <queue>
+#include <string>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+using namespace std;
+
+// GRAPH REORDERING
+
+enum class ReorderStrategy { NONE, DEGREE, RCM, BFS, COMMUNITY };
+
+inline bool parse_reorder_strategy(const string& name, ReorderStrategy& out) {
+    if (name == "none") out = ReorderStrategy::NONE;
+    else if (name == "degree") out = ReorderStrategy::DEGREE;
+    else if (name == "rcm") out = ReorderStrategy::RCM;
+    else if (name == "bfs") out = ReorderStrategy::BFS;
+    else if (name == "community") out = ReorderStrategy::COMMUNITY;
+    else return false;
+    return true;
+}
+
+inline string reorder_strategy_name(ReorderStrategy strategy) {
+    switch (strategy) {
+        case ReorderStrategy::DEGREE: return "degree";
+        case ReorderStrategy::RCM: return "rcm";
+        case ReorderStrategy::BFS: return "bfs";
+        case ReorderStrategy::COMMUNITY: return "community";
+        default: return "none";
+    }
+}
+
+/**
+* @brief: Locality metrics of the current node numbering
+*
+* @var: average_gap: mean |pos(u) - pos(v)| over all adjacency entries
+* @var: average_log_gap: mean log2(1 + gap) between consecutive sorted neighbours,
+*                        roughly the bits per edge a gap encoder would need
+* @var: bandwidth: largest |pos(u) - pos(v)| over all edges
+*
+**/
+struct OrderingMetrics {
+    double average_gap;
+    double average_log_gap;
+    long long bandwidth;
+
+    OrderingMetrics() : average_gap(0.0), average_log_gap(0.0), bandwidth(0) {}
+};
+
+class GraphReordering {
+private:
+    // Dense 0..n-1 view of the graph in map order, used by every strategy
+    struct DenseView {
+        vector<NodeID> ids;
+        vector<vector<int>> neighbors;
+    };
+
+    static DenseView make_dense_view(const Graph& g) {
+        DenseView view;
+        unordered_map<NodeID, int> index;
+        const auto& adj = g.get_adj_list();
+        view.ids.reserve(adj.size());
+        for (const auto& p : adj) {
+            index[p.first] = (int)view.ids.size();
+            view.ids.push_back(p.first);
+        }
+        view.neighbors.resize(view.ids.size());
+        for (const auto& p : adj) {
+            auto& list = view.neighbors[index[p.first]];
+            for (const auto& edge : p.second) {
+                list.push_back(index[edge.target]);
+            }
+            sort(list.begin(), list.end());
+        }
+        return view;
+    }
+
+    static vector<NodeID> to_ids(const DenseView& view, const vector<int>& order) {
+        vector<NodeID> result;
+        result.reserve(order.size());
+        for (int i : order) result.push_back(view.ids[i]);
+        return result;
+    }
+
+    // BFS over every component; roots are taken in the given priority order
+    static vector<int> bfs_from_roots(const DenseView& view, const vector<int>& roots,
+                                      bool neighbors_by_degree) {
+        int n = view.ids.size();
+        vector<int> order;
+        order.reserve(n);
+        vector<char> visited(n, 0);
+        vector<int> next;
+
+        for (int root : roots) {
+            if (visited[root]) continue;
+            visited[root] = 1;
+            queue<int> q;
+            q.push(root);
+
+            while (!q.empty()) {
+                int u = q.front();
+                q.pop();
+                order.push_back(u);
+
+                next.clear();
+                for (int v : view.neighbors[u]) {
+                    if (!visited[v]) {
+                        visited[v] = 1;
+                        next.push_back(v);
+                    }
+                }
+                if (neighbors_by_degree) {
+                    stable_sort(next.begin(), next.end(), [&](int a, int b) {
+                        return view.neighbors[a].size() < view.neighbors[b].size();
+                    });
+                }
+                for (int v : next) q.push(v);
+            }
+        }
+        return order;
+    }
+
+    static vector<int> nodes_by_degree(const DenseView& view, bool descending) {
+        vector<int> nodes(view.ids.size());
+        for (size_t i = 0; i < nodes.size(); ++i) nodes[i] = i;
+        stable_sort(nodes.begin(), nodes.end(), [&](int a, int b) {
+            size_t da = view.neighbors[a].size(), db = view.neighbors[b].size();
+            return descending ? da > db : da < db;
+        });
+        return nodes;
+    }
+
+public:
+    // Hubs first, so the most frequently touched adjacency lists share cache lines
+    static vector<NodeID> degree_order(const Graph& g) {
+        DenseView view = make_dense_view(g);
+        return to_ids(view, nodes_by_degree(view, true));
+    }
+
+    static vector<NodeID> bfs_order(const Graph& g) {
+        DenseView view = make_dense_view(g);
+        return to_ids(view, bfs_from_roots(view, nodes_by_degree(view, true), false));
+    }
+
+    // Reverse Cuthill-McKee: start each component at a low degree (peripheral) node,
+    // visit neighbours by ascending degree, then reverse the whole sequence
+    static vector<NodeID> rcm_order(const Graph& g) {
+        DenseView view = make_dense_view(g);
+        vector<int> order = bfs_from_roots(view, nodes_by_degree(view, false), true);
+        reverse(order.begin(), order.end());
+        return to_ids(view, order);
+    }
+
+    // Clusters nodes with label propagation, then lays clusters out contiguously.
+    // Clusters appear in the order BFS first reaches them; members keep their BFS order.
+    static vector<NodeID> community_order(const Graph& g, int max_iterations = 20) {
+        DenseView view = make_dense_view(g);
+        int n = view.ids.size();
+
+        vector<int> label(n);
+        for (int i = 0; i < n; ++i) label[i] = i;
+
+        unordered_map<int, int> counts;
+        for (int iter = 0; iter < max_iterations; ++iter) {
+            bool changed = false;
+            for (int u = 0; u < n; ++u) {
+                if (view.neighbors[u].empty()) continue;
+                counts.clear();
+                for (int v : view.neighbors[u]) counts[label[v]]++;
+
+                int best_label = label[u];
+                int best_count = 0;
+                for (const auto& c : counts) {
+                    if (c.second > best_count ||
+                        (c.second == best_count && c.first < best_label)) {
+                        best_label = c.first;
+                        best_count = c.second;
+                    }
+                }
+                if (best_label != label[u]) {
+                    label[u] = best_label;
+                    changed = true;
+                }
+            }
+            if (!changed) break;
+        }
+
+        vector<int> bfs = bfs_from_roots(view, nodes_by_degree(view, true), false);
+        vector<int> bfs_pos(n);
+        for (int i = 0; i < n; ++i) bfs_pos[bfs[i]] = i;
+
+        unordered_map<int, int> cluster_rank;
+        for (int u : bfs) {
+            if (!cluster_rank.count(label[u])) {
+                int rank = cluster_rank.size();
+                cluster_rank[label[u]] = rank;
+            }
+        }
+
+        vector<int> order = bfs;
+        stable_sort(order.begin(), order.end(), [&](int a, int b) {
+            int ra = cluster_rank[label[a]], rb = cluster_rank[label[b]];
+            if (ra != rb) return ra < rb;
+            return bfs_pos[a] < bfs_pos[b];
+        });
+        return to_ids(view, order);
+    }
+
+    static vector<NodeID> compute_order(const Graph& g, ReorderStrategy strategy) {
+        switch (strategy) {
+            case ReorderStrategy::DEGREE: return degree_order(g);
+            case ReorderStrategy::RCM: return rcm_order(g);
+            case ReorderStrategy::BFS: return bfs_order(g);
+            case ReorderStrategy::COMMUNITY: return community_order(g);
+            default: {
+                vector<NodeID> order;
+                for (const auto& p : g.get_adj_list()) order.push_back(p.first);
+                return order;
+            }
+        }
+    }
+
+    /**
+    *@brief: builds a copy of g where order[i] becomes node i
+    *
+    *@return: the relabeled graph; neighbour lists come out sorted by new ID and
+    *         original_id() maps every node back to its ID in the input file
+    *
+    **/
+    static Graph relabel(const Graph& g, const vector<NodeID>& order) {
+        unordered_map<NodeID, NodeID> new_id;
+        vector<NodeID> original(order.size());
+        for (size_t i = 0; i < order.size(); ++i) {
+            new_id[order[i]] = (NodeID)i;
+            original[i] = g.original_id(order[i]);
+        }
+
+        Graph result;
+        vector<pair<NodeID, double>> targets;
+        for (size_t i = 0; i < order.size(); ++i) {
+            NodeID u = (NodeID)i;
+            targets.clear();
+            for (const auto& edge : g.get_neighbors(order[i])) {
+                NodeID v = new_id[edge.target];
+                if (v >= u) targets.push_back({v, edge.probability});
+            }
+            sort(targets.begin(), targets.end());
+            for (const auto& t : targets) {
+                result.add_edge(u, t.first, t.second);
+            }
+        }
+        result.set_original_ids(original);
+        return result;
+    }
+
+    static Graph reorder(const Graph& g, ReorderStrategy strategy) {
+        return relabel(g, compute_order(g, strategy));
+    }
+
+    // Positions are ranks in map order, so the input and relabeled graphs are comparable
+    static OrderingMetrics compute_metrics(const Graph& g) {
+        OrderingMetrics metrics;
+        unordered_map<NodeID, long long> pos;
+        for (const auto& p : g.get_adj_list()) {
+            long long rank = pos.size();
+            pos[p.first] = rank;
+        }
+
+        long long entries = 0, gaps = 0;
+        double gap_sum = 0.0, log_gap_sum = 0.0;
+        vector<long long> sorted_pos;
+
+        for (const auto& p : g.get_adj_list()) {
+            long long pu = pos[p.first];
+            sorted_pos.clear();
+            for (const auto& edge : p.second) {
+                long long pv = pos[edge.target];
+                long long d = llabs(pu - pv);
+                gap_sum += d;
+                metrics.bandwidth = max(metrics.bandwidth, d);
+                sorted_pos.push_back(pv);
+                entries++;
+            }
+            sort(sorted_pos.begin(), sorted_pos.end());
+
+            long long prev = pu;
+            for (size_t i = 0; i < sorted_pos.size(); ++i) {
+                long long d = (i == 0) ? llabs(sorted_pos[i] - prev) : sorted_pos[i] - prev;
+                log_gap_sum += log2(1.0 + d);
+                prev = sorted_pos[i];
+                gaps++;
+            }
+        }
+
+        if (entries > 0) metrics.average_gap = gap_sum / entries;
+        if (gaps > 0) metrics.average_log_gap = log_gap_sum / gaps;
+        return metrics;
+    }
+};
+
+#endif
@@ -0,0 +1,371 @@
+#ifndef INFLUENCE_ORACLE_H
+#define INFLUENCE_ORACLE_H
+
+#include "data_loader.h"
+#include "integrated_social_network.h"
+#include <vector>
+#include <string>
+#include <fstream>
+#include <algorithm>
+#include <cstdint>
+#include <cmath>
+
+using namespace std;
+
+// INFLUENCE ORACLE
+
+/**
+* @var: num_instances: live-edge samples of the ICM; spread is averaged over them
+* @var: sketch_size: k of the bottom-k sketches, error is about 1/sqrt(k - 2)
+*
+**/
+struct InfluenceOracleOptions {
+    int num_instances = 64;
+    int sketch_size = 64;
+    uint64_t seed = 2024;
+};
+
+/**
+* @brief: Answers ICM spread queries from combined bottom-k reachability sketches
+*
+* Every (node, instance) pair gets a random rank. In an instance an edge u -> v
+* is live with the same probability simulate_ICM uses, decided by hashing, so
+* instances are never materialised. A node's sketch holds the k smallest ranks
+* among the pairs it reaches across all instances (SKIM / Cohen et al.). The
+* spread of a seed set comes from the union of its sketches, in O(|S| k) time.
+*
+**/
+class InfluenceOracle {
+private:
+    InfluenceOracleOptions options;
+    vector<NodeID> ids;                // sorted, dense index -> node ID
+    vector<size_t> sketch_offsets;     // sketch of node i is ranks[offsets[i] .. offsets[i + 1])
+    vector<uint64_t> ranks;
+    uint64_t fingerprint = 0;
+
+    static uint64_t mix(uint64_t x) {
+        x += 0x9E3779B97F4A7C15ULL;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+        return x ^ (x >> 31);
+    }
+
+    int index_of(NodeID node) const {
+        auto it = lower_bound(ids.begin(), ids.end(), node);
+        if (it == ids.end() || *it != node) return -1;
+        return it - ids.begin();
+    }
+
+    // Sorted union of two sketches cut back to k entries
+    void merge_into(vector<uint64_t>& acc, int node, vector<uint64_t>& scratch) const {
+        scratch.clear();
+        size_t k = options.sketch_size;
+        auto a = acc.begin();
+        auto b = ranks.begin() + sketch_offsets[node];
+        auto b_end = ranks.begin() + sketch_offsets[node + 1];
+        while (scratch.size() < k && (a != acc.end() || b != b_end)) {
+            uint64_t next;
+            if (b == b_end || (a != acc.end() && *a <= *b)) {
+                next = *a++;
+                if (b != b_end && *b == next) ++b;
+            } else {
+                next = *b++;
+            }
+            scratch.push_back(next);
+        }
+        acc.swap(scratch);
+    }
+
+    // Reachable (node, instance) pairs, divided by the number of instances. A full
+    // sketch is only an estimate, so it is held to what num_seeds seeds can reach.
+    double estimate(const vector<uint64_t>& sketch, size_t num_seeds) const {
+        double pairs;
+        if (sketch.size() < (size_t)options.sketch_size) {
+            pairs = sketch.size();
+        } else {
+            double tau = (sketch.back() + 1.0) / 18446744073709551616.0;
+            pairs = (options.sketch_size - 1) / tau;
+        }
+        double spread = pairs / options.num_instances;
+        return max((double)num_seeds, min((double)ids.size(), spread));
+    }
+
+public:
+    class Query {
+    private:
+        const InfluenceOracle* oracle;
+        vector<uint64_t> sketch;
+        vector<int> seeds;   // distinct indices added so far
+        mutable vector<uint64_t> scratch;
+
+        bool has_seed(int node) const {
+            return find(seeds.begin(), seeds.end(), node) != seeds.end();
+        }
+
+    public:
+        explicit Query(const InfluenceOracle* o) : oracle(o) {}
+
+        void add(NodeID node) {
+            int i = oracle->index_of(node);
+            if (i < 0 || has_seed(i)) return;
+            seeds.push_back(i);
+            oracle->merge_into(sketch, i, scratch);
+        }
+
+        double spread() const {
+            return oracle->estimate(sketch, seeds.size());
+        }
+
+        double marginal_gain(NodeID node) const {
+            int i = oracle->index_of(node);
+            if (i < 0 || has_seed(i)) return 0.0;
+            vector<uint64_t> with = sketch;
+            oracle->merge_into(with, i, scratch);
+            return oracle->estimate(with, seeds.size() + 1) - spread();
+        }
+    };
+
+    InfluenceOracle() {}
+
+    // Order-independent hash of the edge set, used to reject stale sketch files
+    template <typename GraphT>
+    static uint64_t graph_fingerprint(const GraphT& g) {
+        uint64_t h = 0;
+        for (const auto& p : g.get_adj_list()) {
+            h += mix((uint64_t)(uint32_t)p.first);
+            for (const auto& edge : g.get_neighbors(p.first)) {
+                if (p.first < edge.target) {
+                    h += mix(((uint64_t)(uint32_t)p.first << 32) | (uint32_t)edge.target);
+                }
+            }
+        }
+        return h;
+    }
+
+    template <typename GraphT>
+    static InfluenceOracle build(const GraphT& g,
+                                 const InfluenceOracleOptions& options = InfluenceOracleOptions()) {
+        InfluenceOracle oracle;
+        oracle.options = options;
+        oracle.fingerprint = graph_fingerprint(g);
+        for (const auto& p : g.get_adj_list()) oracle.ids.push_back(p.first);
+        sort(oracle.ids.begin(), oracle.ids.end());
+        int n = oracle.ids.size();
+        int R = options.num_instances;
+        size_t k = options.sketch_size;
+
+        // CSR with the ICM probability of every directed edge
+        vector<size_t> offsets(1, 0);
+        vector<int> targets;
+        vector<uint64_t> thresholds;
+        for (NodeID u : oracle.ids) {
+            for (const auto& edge : g.get_neighbors(u)) {
+                double p = calculate_influence_probability(count_common_neighbors(g, u, edge.target));
+                targets.push_back(oracle.index_of(edge.target));
+                thresholds.push_back(p >= 1.0 ? UINT64_MAX : (uint64_t)ldexp(p, 64));
+            }
+            offsets.push_back(targets.size());
+        }
+
+        auto live = [&](int instance, int from, int to, size_t e) {
+            uint64_t h = mix(mix(mix(options.seed + instance) + from) + to);
+            return h < thresholds[e] || thresholds[e] == UINT64_MAX;
+        };
+
+        // A node's k smallest ranks overall are among the k smallest of each
+        // instance, so instances are sketched one at a time and merged as they go.
+        // Within one instance reachability is transitive: a node that already holds
+        // k ranks of it passes all of them on to everything upstream, so the reverse
+        // search stops there and each node is expanded at most k times per instance.
+        vector<vector<uint64_t>> sketches(n);
+        vector<pair<uint64_t, int>> order(n);   // (rank, node) of the current instance
+        vector<int> in_instance(n);
+        vector<int> stamp(n, -1);
+        vector<int> stack;
+        int epoch = 0;
+
+        for (int instance = 0; instance < R; ++instance) {
+            for (int u = 0; u < n; ++u) order[u] = {mix(mix(~options.seed + u) + instance), u};
+            sort(order.begin(), order.end());
+            fill(in_instance.begin(), in_instance.end(), 0);
+            int full = 0;
+
+            for (const auto& entry : order) {
+                if (full == n) break;
+                uint64_t rank = entry.first;
+
+                ++epoch;
+                stack.assign(1, entry.second);
+                stamp[entry.second] = epoch;
+                while (!stack.empty()) {
+                    int y = stack.back();
+                    stack.pop_back();
+                    if (in_instance[y] == (int)k) continue;
+                    if (++in_instance[y] == (int)k) full++;
+
+                    vector<uint64_t>& sketch = sketches[y];
+                    if (sketch.size() < k || rank < sketch.back()) {
+                        sketch.insert(lower_bound(sketch.begin(), sketch.end(), rank), rank);
+                        if (sketch.size() > k) sketch.pop_back();
+                    }
+
+                    for (size_t e = offsets[y]; e < offsets[y + 1]; ++e) {
+                        int x = targets[e];
+                        if (stamp[x] == epoch) continue;
+                        // live x -> y; probabilities are symmetric, the coin is not
+                        if (live(instance, x, y, e)) {
+                            stamp[x] = epoch;
+                            stack.push_back(x);
+                        }
+                    }
+                }
+            }
+        }
+
+        oracle.sketch_offsets.push_back(0);
+        for (int u = 0; u < n; ++u) {
+            oracle.ranks.insert(oracle.ranks.end(), sketches[u].begin(), sketches[u].end());
+            oracle.sketch_offsets.push_back(oracle.ranks.size());
+        }
+        return oracle;
+    }
+
+    Query query() const {
+        return Query(this);
+    }
+
+    double estimate_spread(const vector<NodeID>& seeds) const {
+        Query q = query();
+        for (NodeID s : seeds) q.add(s);
+        return q.spread();
+    }
+
+    double marginal_gain(const vector<NodeID>& seeds, NodeID node) const {
+        Query q = query();
+        for (NodeID s : seeds) q.add(s);
+        return q.marginal_gain(node);
+    }
+
+    // Same greedy rule as InfluenceMaximization::greedy_seed_selection, on sketches
+    vector<NodeID> greedy_seeds(int k) const {
+        vector<NodeID> seeds;
+        Query q = query();
+        vector<char> chosen(ids.size(), 0);
+        for (int round = 0; round < k; ++round) {
+            int best = -1;
+            double best_gain = -1.0;
+            for (size_t i = 0; i < ids.size(); ++i) {
+                if (chosen[i]) continue;
+                double gain = q.marginal_gain(ids[i]);
+                if (gain > best_gain) {
+                    best_gain = gain;
+                    best = i;
+                }
+            }
+            if (best < 0) break;
+            chosen[best] = 1;
+            seeds.push_back(ids[best]);
+            q.add(ids[best]);
+        }
+        return seeds;
+    }
+
+    template <typename GraphT>
+    bool matches(const GraphT& g) const {
+        return fingerprint == graph_fingerprint(g);
+    }
+
+    // Settings the sketches were built with; load() restores them from the file
+    const InfluenceOracleOptions& get_options() const {
+        return options;
+    }
+
+    bool built_with(const InfluenceOracleOptions& other) const {
+        return options.num_instances == other.num_instances &&
+               options.sketch_size == other.sketch_size && options.seed == other.seed;
+    }
+
+    // Peak while building: the probability CSR, one instance's rank order and
+    // counters, and the sketches, which are copied into the final array
+    static size_t estimate_build_bytes(size_t n, size_t entries,
+                                       const InfluenceOracleOptions& options = InfluenceOracleOptions()) {
+        size_t csr = n * sizeof(size_t) + entries * (sizeof(int) + sizeof(uint64_t));
+        size_t order = n * (sizeof(pair<uint64_t, int>) + sizeof(int));
+        size_t sketches = n * (sizeof(vector<uint64_t>) + sizeof(int)) +
+                          2 * n * options.sketch_size * sizeof(uint64_t);
+        return csr + order + sketches;
+    }
+
+    size_t memory_bytes() const {
+        return ids.capacity() * sizeof(NodeID) + sketch_offsets.capacity() * sizeof(size_t) +
+               ranks.capacity() * sizeof(uint64_t);
+    }
+
+    bool save(const string& path) const {
+        ofstream out(path, ios::binary);
+        if (!out) return false;
+        uint64_t header[6] = {0x534E414F52434C31ULL, fingerprint, ids.size(), ranks.size(),
+                              (uint64_t)options.num_instances, (uint64_t)options.sketch_size};
+        out.write((const char*)header, sizeof(header));
+        out.write((const char*)&options.seed, sizeof(options.seed));
+        out.write((const char*)ids.data(), ids.size() * sizeof(NodeID));
+        for (size_t off : sketch_offsets) {
+            uint64_t v = off;
+            out.write((const char*)&v, sizeof(v));
+        }
+        out.write((const char*)ranks.data(), ranks.size() * sizeof(uint64_t));
+        return (bool)out;
+    }
+
+    // Rejects truncated or inconsistent files instead of trusting their header
+    bool load(const string& path) {
+        ifstream in(path, ios::binary | ios::ate);
+        if (!in) return false;
+        uint64_t file_bytes = (uint64_t)in.tellg();
+        in.seekg(0);
+
+        const uint64_t MAGIC = 0x534E414F52434C31ULL;
+        uint64_t header[6];
+        if (!in.read((char*)header, sizeof(header)) || header[0] != MAGIC) return false;
+
+        uint64_t num_ids = header[2], num_ranks = header[3];
+        uint64_t instances = header[4], sketch_size = header[5];
+        uint64_t fixed_bytes = sizeof(header) + sizeof(uint64_t) + sizeof(uint64_t);   // + seed, first offset
+        if (instances == 0 || instances > INT32_MAX || sketch_size == 0 || sketch_size > INT32_MAX) return false;
+        if (file_bytes < fixed_bytes || num_ids > (file_bytes - fixed_bytes) / (sizeof(NodeID) + sizeof(uint64_t)))
+            return false;
+        uint64_t rest = file_bytes - fixed_bytes - num_ids * (sizeof(NodeID) + sizeof(uint64_t));
+        if (rest != num_ranks * sizeof(uint64_t) || num_ranks / sketch_size > num_ids) return false;
+
+        InfluenceOracle loaded;
+        loaded.fingerprint = header[1];
+        loaded.options.num_instances = instances;
+        loaded.options.sketch_size = sketch_size;
+        loaded.ids.resize(num_ids);
+        loaded.sketch_offsets.resize(num_ids + 1);
+        loaded.ranks.resize(num_ranks);
+        in.read((char*)&loaded.options.seed, sizeof(loaded.options.seed));
+        in.read((char*)loaded.ids.data(), loaded.ids.size() * sizeof(NodeID));
+        for (size_t& off : loaded.sketch_offsets) {
+            uint64_t v;
+            in.read((char*)&v, sizeof(v));
+            off = v;
+        }
+        in.read((char*)loaded.ranks.data(), loaded.ranks.size() * sizeof(uint64_t));
+        if (!in) return false;
+
+        // ids sorted for index_of, sketches in bounds and at most k long
+        for (size_t i = 1; i < loaded.ids.size(); ++i) {
+            if (loaded.ids[i - 1] >= loaded.ids[i]) return false;
+        }
+        if (loaded.sketch_offsets.front() != 0 || loaded.sketch_offsets.back() != loaded.ranks.size()) return false;
+        for (size_t i = 0; i < num_ids; ++i) {
+            size_t begin = loaded.sketch_offsets[i], end = loaded.sketch_offsets[i + 1];
+            if (end < begin || end - begin > sketch_size) return false;
+        }
+        *this = loaded;
+        return true;
+    }
+};
+
+#endif
@@ -16,7 +16,8 @@
 using namespace std;
 
 // UTILITY FUNCTIONS
-inline int count_common_neighbors(const Graph& g, NodeID A, NodeID B) {
+template <typename GraphT>
+inline int count_common_neighbors(const GraphT& g, NodeID A, NodeID B) {
     set<NodeID> neighbors_A;
     for (const auto& edge : g.get_neighbors(A)) {
         neighbors_A.insert(edge.target);  
@@ -72,7 +73,8 @@ struct BrandesPhase1Result{
 
 class BetweennessCentrality {
 public:
-    static BrandesPhase1Result Brandes_Phase_1_BFS(const Graph& g, NodeID src){
+    template <typename GraphT>
+    static BrandesPhase1Result Brandes_Phase_1_BFS(const GraphT& g, NodeID src){
         BrandesPhase1Result result;
         queue<int> q;
         q.push(src);
@@ -114,7 +116,8 @@ public:
         return result;
     }
 
-    static unordered_map<NodeID, double> compute_betweenness_centrality(const Graph& g){
+    template <typename GraphT>
+    static unordered_map<NodeID, double> compute_betweenness_centrality(const GraphT& g){
         unordered_map<NodeID, double> centrality_score;
 
         for(const auto& p : g.get_adj_list())
@@ -151,7 +154,8 @@ public:
         return centrality_score;
     }
 
-    static vector<NodeID> get_top_k_nodes(const Graph& g, int k){
+    template <typename GraphT>
+    static vector<NodeID> get_top_k_nodes(const GraphT& g, int k){
         auto bc = compute_betweenness_centrality(g);
         vector<pair<double, NodeID>> arr;
 
@@ -173,7 +177,8 @@ public:
 // INDEPENDENT CASCADE MODEL
 class InfluenceMaximization {
 public:
-    static int simulate_ICM(const Graph& g, const set<NodeID>& seed_set,
+    template <typename GraphT>
+    static int simulate_ICM(const GraphT& g, const set<NodeID>& seed_set,
                            int num_simulations = 1000) {
         long long total_spread = 0;
         random_device rd;
@@ -206,7 +211,8 @@ public:
         return (int)(total_spread / num_simulations);
     }
 
-    static set<NodeID> greedy_seed_selection(const Graph& g, int k,
+    template <typename GraphT>
+    static set<NodeID> greedy_seed_selection(const GraphT& g, int k,
                                              int simulations_per_eval = 100) {
         set<NodeID> seeds;
         const auto& adj = g.get_adj_list();
@@ -234,7 +240,7 @@ public:
 
             if (best_node != -1) {
                 seeds.insert(best_node);
-                cout << "  Seed " << (i+1) << ": Node " << best_node
+                cout << "  Seed " << (i+1) << ": Node " << g.original_id(best_node)
                      << " (marginal spread: " << best_spread << ")" << endl;
             }
         }
@@ -250,15 +256,18 @@ struct RecommendationScore {
     double adamic_adar_score;
     double combined_score;
     double influence_potential;
+    double ppr_score;
 
     RecommendationScore() : candidate_id(-1), common_neighbors_count(0),
                            jaccard_score(0.0), adamic_adar_score(0.0),
-                           combined_score(0.0), influence_potential(0.0) {}
+                           combined_score(0.0), influence_potential(0.0),
+                           ppr_score(0.0) {}
 };
 
 class FriendRecommendation {
 public:
-    static double jaccard_coefficient(const Graph& g, NodeID u, NodeID v) {
+    template <typename GraphT>
+    static double jaccard_coefficient(const GraphT& g, NodeID u, NodeID v) {
         set<NodeID> neighbors_u, neighbors_v, union_set;
 
         for (const auto& edge : g.get_neighbors(u)) {
@@ -280,7 +289,8 @@ public:
         return (double)intersection / union_set.size();
     }
 
-    static double adamic_adar_index(const Graph& g, NodeID u, NodeID v) {
+    template <typename GraphT>
+    static double adamic_adar_index(const GraphT& g, NodeID u, NodeID v) {
         set<NodeID> neighbors_u;
         for (const auto& edge : g.get_neighbors(u)) {
             neighbors_u.insert(edge.target);   
@@ -299,8 +309,9 @@ public:
         return score;
     }
 
+    template <typename GraphT>
     static vector<RecommendationScore> get_recommendations(
-        const Graph& g, NodeID user, int max_recs = 10) {
+        const GraphT& g, NodeID user, int max_recs = 10) {
         
         set<NodeID> direct_friends;
         for (const auto& edge : g.get_neighbors(user)) {
@@ -345,7 +356,8 @@ public:
         return recommendations;
     }
 
-    static vector<NodeID> recommend_friends_simple(const Graph& g, NodeID user, int n = 10) {
+    template <typename GraphT>
+    static vector<NodeID> recommend_friends_simple(const GraphT& g, NodeID user, int n = 10) {
         auto recs = get_recommendations(g, user, n);
         vector<NodeID> result;
         for (const auto& rec : recs) {
@@ -358,8 +370,9 @@ public:
 // HYBRID ANALYSIS
 class HybridAnalysis {
 public:
+    template <typename GraphT>
     static vector<pair<NodeID, double>> find_influential_friend_candidates(
-        const Graph& g, NodeID user, int top_k = 10) {
+        const GraphT& g, NodeID user, int top_k = 10) {
         
         auto bc_scores = BetweennessCentrality::compute_betweenness_centrality(g);
         auto recommendations = FriendRecommendation::get_recommendations(g, user, 50);
@@ -382,7 +395,8 @@ public:
         return scored_candidates;
     }
 
-    static void analyze_recommendation_impact(const Graph& g, NodeID user,
+    template <typename GraphT>
+    static void analyze_recommendation_impact(const GraphT& g, NodeID user,
                                              const set<NodeID>& initial_seeds,
                                              int num_simulations = 1000) {
         cout << "\n=== Analyzing Recommendation Impact on Influence Spread ===" << endl;
@@ -391,16 +405,16 @@ public:
         cout << "Baseline spread: " << baseline_spread << " nodes" << endl;
 
         auto recommendations = FriendRecommendation::recommend_friends_simple(g, user, 5);
-        cout << "\nTop 5 recommended friends for User " << user << ":" << endl;
+        cout << "\nTop 5 recommended friends for User " << g.original_id(user) << ":" << endl;
         for (size_t i = 0; i < recommendations.size(); ++i) {
-            cout << "  " << (i+1) << ". Node " << recommendations[i] << endl;
+            cout << "  " << (i+1) << ". Node " << g.original_id(recommendations[i]) << endl;
         }
 
         cout << "\nInfluence potential of connecting with each recommendation:" << endl;
         for (NodeID candidate : recommendations) {
             int common = count_common_neighbors(g, user, candidate);
             double prob = calculate_influence_probability(common);
-            cout << "  Node " << candidate << ": " << common
+            cout << "  Node " << g.original_id(candidate) << ": " << common
                  << " common neighbors → " << (prob * 100) << "% influence probability" << endl;
         }
     }
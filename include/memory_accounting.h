@@ -0,0 +1,275 @@
+#ifndef MEMORY_ACCOUNTING_H
+#define MEMORY_ACCOUNTING_H
+
+#include "data_loader.h"
+#include "compressed_graph.h"
+#include "weighted_betweenness.h"
+#include "influence_oracle.h"
+#include <vector>
+#include <string>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <iomanip>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <algorithm>
+#include <cstdlib>
+
+using namespace std;
+
+// MEMORY ACCOUNTING
+
+/**
+* @brief: Process-wide live and peak heap bytes
+*
+* Fed by a counting operator new / delete; the sna program installs one on
+* glibc, sized with malloc_usable_size() plus the chunk header so the counts line
+* up with MemoryFootprint::heap_block(). The test binary installs none, so there
+* the counters stay at zero unless fed by hand.
+*
+**/
+class HeapCounter {
+private:
+    static inline atomic<long long> live{0};
+    static inline atomic<long long> peak{0};
+    static inline atomic<bool> enabled{false};
+
+public:
+    static void enable() {
+        enabled.store(true, memory_order_relaxed);
+    }
+
+    static bool is_enabled() {
+        return enabled.load(memory_order_relaxed);
+    }
+
+    static void record_alloc(size_t bytes) {
+        long long now = live.fetch_add(bytes, memory_order_relaxed) + bytes;
+        long long seen = peak.load(memory_order_relaxed);
+        while (now > seen && !peak.compare_exchange_weak(seen, now, memory_order_relaxed)) {}
+    }
+
+    static void record_free(size_t bytes) {
+        live.fetch_sub(bytes, memory_order_relaxed);
+    }
+
+    static size_t live_bytes() {
+        return max(0LL, live.load(memory_order_relaxed));
+    }
+
+    static size_t peak_bytes() {
+        return max(0LL, peak.load(memory_order_relaxed));
+    }
+
+    static void reset_peak() {
+        peak.store(live.load(memory_order_relaxed), memory_order_relaxed);
+    }
+};
+
+// Resident set size from /proc; every call returns 0 where that is not available
+class ResidentMemory {
+private:
+    static size_t read_status_kb(const string& key) {
+        ifstream status("/proc/self/status");
+        string line;
+        while (getline(status, line)) {
+            if (line.compare(0, key.size(), key) == 0) {
+                return strtoull(line.c_str() + key.size(), nullptr, 10) * 1024;
+            }
+        }
+        return 0;
+    }
+
+public:
+    static size_t current_bytes() {
+        return read_status_kb("VmRSS:");
+    }
+
+    static size_t peak_bytes() {
+        return read_status_kb("VmHWM:");
+    }
+
+    // Linux lets a process restart its high-water mark by writing 5 to clear_refs
+    static bool reset_peak() {
+        ofstream clear("/proc/self/clear_refs");
+        if (!clear) return false;
+        clear << "5";
+        clear.flush();
+        return (bool)clear;
+    }
+};
+
+struct MemoryEntry {
+    string name;
+    size_t bytes;
+};
+
+struct MemoryReport {
+    vector<MemoryEntry> entries;
+
+    void add(const string& name, size_t bytes) {
+        entries.push_back({name, bytes});
+    }
+
+    size_t total() const {
+        size_t sum = 0;
+        for (const auto& e : entries) sum += e.bytes;
+        return sum;
+    }
+
+    void print(ostream& out) const {
+        for (const auto& e : entries) {
+            out << "  " << left << setw(28) << e.name << right << setw(12) << fixed << setprecision(1)
+                << e.bytes / 1024.0 << " KB" << endl;
+        }
+        out << "  " << left << setw(28) << "Total" << right << setw(12) << total() / 1024.0 << " KB"
+            << left << endl;
+    }
+};
+
+/**
+* @brief: Memory used by one algorithm phase
+*
+* @var: heap_peak_bytes: highest heap in use during the phase, above what was live
+*                        when it started (0 without the counting allocator)
+* @var: rss_peak_bytes: resident high-water mark of the phase, or of the process
+*                       so far when the kernel cannot reset it (0 off Linux)
+*
+**/
+struct PhaseUsage {
+    string name;
+    long long elapsed_ms = 0;
+    size_t heap_peak_bytes = 0;
+    size_t rss_peak_bytes = 0;
+};
+
+// Records a PhaseUsage for its scope
+class PhaseTracker {
+private:
+    vector<PhaseUsage>& log;
+    PhaseUsage usage;
+    size_t heap_start;
+    chrono::high_resolution_clock::time_point start;
+
+public:
+    PhaseTracker(vector<PhaseUsage>& phase_log, const string& name) : log(phase_log) {
+        usage.name = name;
+        ResidentMemory::reset_peak();
+        HeapCounter::reset_peak();
+        heap_start = HeapCounter::live_bytes();
+        start = chrono::high_resolution_clock::now();
+    }
+
+    ~PhaseTracker() {
+        auto end = chrono::high_resolution_clock::now();
+        usage.elapsed_ms = chrono::duration_cast<chrono::milliseconds>(end - start).count();
+        size_t heap_peak = HeapCounter::peak_bytes();
+        usage.heap_peak_bytes = heap_peak > heap_start ? heap_peak - heap_start : 0;
+        usage.rss_peak_bytes = ResidentMemory::peak_bytes();
+        log.push_back(usage);
+    }
+};
+
+class MemoryFootprint {
+public:
+    // glibc malloc chunk for a request: 8 bytes of header, 16-byte granularity, 32 minimum
+    static size_t heap_block(size_t bytes) {
+        if (bytes == 0) return 0;
+        return max<size_t>(32, (bytes + 8 + 15) & ~(size_t)15);
+    }
+
+    /**
+    *@brief: heap held by a Graph, split by structure
+    *
+    *@return: one entry per structure; red-black tree nodes carry 32 bytes of links and colour
+    *
+    **/
+    static MemoryReport graph(const Graph& g) {
+        MemoryReport report;
+        const auto& adj = g.get_adj_list();
+        size_t tree = 0, lists = 0;
+        for (const auto& p : adj) {
+            tree += heap_block(32 + sizeof(p));
+            lists += heap_block(p.second.capacity() * sizeof(InfluenceEdge));
+        }
+        report.add("Adjacency tree nodes", tree);
+        report.add("Neighbour lists", lists);
+        if (g.is_relabeled()) {
+            size_t n = adj.size();
+            size_t id_maps = heap_block(n * sizeof(NodeID)) +
+                             n * heap_block(sizeof(void*) + sizeof(pair<NodeID, NodeID>)) +
+                             heap_block(n * sizeof(void*));
+            report.add("ID maps", id_maps);
+        }
+        return report;
+    }
+
+    static MemoryReport graph(const CompressedGraph& g) {
+        MemoryReport report;
+        report.add("Compressed adjacency", g.memory_bytes());
+        return report;
+    }
+
+    // Map based Brandes: per-source hash maps for dist, sigma, predecessors and delta,
+    // with one predecessor vector per node, plus the score map
+    static size_t brandes_bytes(size_t n, size_t entries) {
+        size_t hash_node = heap_block(sizeof(void*) + 16);
+        size_t per_source = 4 * (n * hash_node + heap_block(n * sizeof(void*))) +
+                            n * heap_block(2 * sizeof(int)) + entries * sizeof(int) +
+                            n * sizeof(int);   // stack and queue
+        return per_source + n * hash_node;
+    }
+
+    // One ICM simulation: the active set as a tree and the BFS queue
+    static size_t icm_bytes(size_t n) {
+        return n * (heap_block(32 + sizeof(NodeID)) + sizeof(NodeID));
+    }
+};
+
+/**
+* @brief: Picks cheaper engine settings before a run so its estimate fits a budget
+*
+* A budget of 0 means unlimited. Every function returns the requested setting
+* unchanged when it already fits.
+*
+**/
+class MemoryPlanner {
+public:
+    // Budget left once in_use bytes are held; 0 stays unlimited, a spent budget leaves 1
+    static size_t remaining(size_t budget, size_t in_use) {
+        if (budget == 0) return 0;
+        return budget > in_use ? budget - in_use : 1;
+    }
+
+    // Most threads (up to requested, 0 = all cores) whose workspaces fit; at least 1
+    static int weighted_bc_threads(size_t n, size_t entries, size_t budget, int requested) {
+        int threads = requested;
+        if (threads <= 0) threads = max(1u, thread::hardware_concurrency());
+        if (budget == 0) return threads;
+        while (threads > 1 && WeightedBetweennessCentrality::estimate_bytes(n, entries, threads) > budget) {
+            threads--;
+        }
+        return threads;
+    }
+
+    // Whether the map based BC fits, otherwise callers switch to the CSR engine
+    static bool brandes_fits(size_t n, size_t entries, size_t budget) {
+        return budget == 0 || MemoryFootprint::brandes_bytes(n, entries) <= budget;
+    }
+
+    // Samples fewer ICM instances first, then shrinks sketches; floors of 8 and 16
+    static InfluenceOracleOptions oracle_options(size_t n, size_t entries, size_t budget,
+                                                 InfluenceOracleOptions options = InfluenceOracleOptions()) {
+        if (budget == 0) return options;
+        while (InfluenceOracle::estimate_build_bytes(n, entries, options) > budget) {
+            if (options.num_instances > 8) options.num_instances /= 2;
+            else if (options.sketch_size > 16) options.sketch_size /= 2;
+            else break;
+        }
+        return options;
+    }
+};
+
+#endif
@@ -0,0 +1,340 @@
+#ifndef MINHASH_INDEX_H
+#define MINHASH_INDEX_H
+
+#include "data_loader.h"
+#include "integrated_social_network.h"
+#include "streaming_graph.h"
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+#include <algorithm>
+#include <cstdint>
+#include <climits>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+using namespace std;
+
+// MINHASH SKETCH INDEX
+
+/**
+* @brief: MinHash signatures of every node's neighbour set plus an LSH band index
+*
+* Each node keeps num_hashes 32-bit minimums so signatures can be updated in
+* place as edges arrive, and a b-bit (low 8 bits) copy that is what queries
+* compare. Signatures are split into bands; nodes whose band rows hash alike
+* share a bucket, which is where candidate lists come from.
+*
+**/
+class MinHashIndex {
+private:
+    struct Signature {
+        vector<uint32_t> mins;
+        vector<uint8_t> low_bits;
+        vector<uint64_t> band_keys;
+        uint32_t degree = 0;
+    };
+
+    int num_hashes;
+    int num_bands;
+    int rows_per_band;
+    vector<uint64_t> seeds;
+    unordered_map<NodeID, Signature> signatures;
+    vector<unordered_map<uint64_t, vector<NodeID>>> buckets;
+
+    static uint64_t mix(uint64_t x) {
+        x += 0x9E3779B97F4A7C15ULL;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+        return x ^ (x >> 31);
+    }
+
+    uint32_t hash(int i, NodeID x) const {
+        return (uint32_t)(mix((uint64_t)(uint32_t)x ^ seeds[i]) >> 32);
+    }
+
+    uint64_t band_key(const Signature& sig, int band) const {
+        uint64_t key = band;
+        for (int r = band * rows_per_band; r < (band + 1) * rows_per_band; ++r) {
+            key = mix(key ^ sig.mins[r]);
+        }
+        return key;
+    }
+
+    Signature& signature_for(NodeID u) {
+        auto it = signatures.find(u);
+        if (it != signatures.end()) return it->second;
+        Signature& sig = signatures[u];
+        sig.mins.assign(num_hashes, UINT32_MAX);
+        sig.low_bits.assign(num_hashes, 0xFF);
+        sig.band_keys.assign(num_bands, 0);
+        return sig;
+    }
+
+    void unlink(NodeID u, int band, uint64_t key) {
+        auto it = buckets[band].find(key);
+        if (it == buckets[band].end()) return;
+        auto& nodes = it->second;
+        auto pos = find(nodes.begin(), nodes.end(), u);
+        if (pos != nodes.end()) {
+            *pos = nodes.back();
+            nodes.pop_back();
+        }
+        if (nodes.empty()) buckets[band].erase(it);
+    }
+
+    // Re-files u under any band whose rows changed
+    void refresh_bands(NodeID u, Signature& sig, bool indexed) {
+        for (int b = 0; b < num_bands; ++b) {
+            uint64_t key = band_key(sig, b);
+            if (indexed && key == sig.band_keys[b]) continue;
+            if (indexed) unlink(u, b, sig.band_keys[b]);
+            sig.band_keys[b] = key;
+            buckets[b][key].push_back(u);
+        }
+    }
+
+    void insert_neighbor(NodeID u, NodeID v) {
+        bool indexed = signatures.count(u) > 0;
+        Signature& sig = signature_for(u);
+        bool changed = false;
+        for (int i = 0; i < num_hashes; ++i) {
+            uint32_t h = hash(i, v);
+            if (h < sig.mins[i]) {
+                sig.mins[i] = h;
+                sig.low_bits[i] = (uint8_t)h;
+                changed = true;
+            }
+        }
+        sig.degree++;
+        if (changed || !indexed) refresh_bands(u, sig, indexed);
+    }
+
+    static int count_matches(const uint8_t* a, const uint8_t* b, int n) {
+        int matches = 0;
+        int i = 0;
+#if defined(__SSE2__)
+        for (; i + 16 <= n; i += 16) {
+            __m128i va = _mm_loadu_si128((const __m128i*)(a + i));
+            __m128i vb = _mm_loadu_si128((const __m128i*)(b + i));
+            matches += __builtin_popcount(_mm_movemask_epi8(_mm_cmpeq_epi8(va, vb)));
+        }
+#endif
+        for (; i < n; ++i) matches += (a[i] == b[i]);
+        return matches;
+    }
+
+public:
+    /**
+    *@param: num_hashes: signature length, rounded up to a multiple of bands
+    *@param: bands: LSH bands; more bands pull in less similar candidates
+    *
+    **/
+    explicit MinHashIndex(int num_hashes = 64, int bands = 16, uint64_t seed = 0x5EED)
+        : num_bands(max(1, bands)) {
+        rows_per_band = max(1, (num_hashes + num_bands - 1) / num_bands);
+        this->num_hashes = rows_per_band * num_bands;
+        buckets.resize(num_bands);
+        for (int i = 0; i < this->num_hashes; ++i) seeds.push_back(mix(seed + i));
+    }
+
+    template <typename GraphT>
+    void build(const GraphT& g) {
+        signatures.clear();
+        for (auto& band : buckets) band.clear();
+        for (const auto& p : g.get_adj_list()) {
+            rebuild_node(g, p.first);
+        }
+    }
+
+    /**
+    *@brief: keeps the index in step with Graph::add_edge(u, v, ...)
+    *
+    * Signatures hold no neighbour lists, so a repeated edge cannot be spotted
+    * here and would count twice in the degree; call this only when
+    * Graph::add_edge() returned true. A self loop is one neighbour, as in the graph.
+    *
+    **/
+    void add_edge(NodeID u, NodeID v) {
+        insert_neighbor(u, v);
+        if (u != v) insert_neighbor(v, u);
+    }
+
+    // Minimums cannot be taken back, so a removal re-reads the node's list
+    template <typename GraphT>
+    void rebuild_node(const GraphT& g, NodeID u) {
+        auto it = signatures.find(u);
+        if (it != signatures.end()) {
+            for (int b = 0; b < num_bands; ++b) unlink(u, b, it->second.band_keys[b]);
+            signatures.erase(it);
+        }
+
+        vector<NodeID> neighbors;
+        for (const auto& edge : g.get_neighbors(u)) neighbors.push_back(edge.target);
+        if (neighbors.empty()) return;
+        sort(neighbors.begin(), neighbors.end());
+        neighbors.erase(unique(neighbors.begin(), neighbors.end()), neighbors.end());
+
+        Signature& sig = signature_for(u);
+        for (NodeID v : neighbors) {
+            for (int i = 0; i < num_hashes; ++i) {
+                sig.mins[i] = min(sig.mins[i], hash(i, v));
+            }
+        }
+        for (int i = 0; i < num_hashes; ++i) sig.low_bits[i] = (uint8_t)sig.mins[i];
+        sig.degree = neighbors.size();
+        refresh_bands(u, sig, false);
+    }
+
+    /**
+    *@brief: brings the index up to a StreamingGraph version
+    *
+    * Endpoints of removed edges are re-read from the snapshot; every other
+    * endpoint of an inserted edge is updated in place. The batch only lists net
+    * changes, so each inserted edge is new to the nodes that are not re-read.
+    *
+    *@param: g: the snapshot published by the apply_batch() call that returned batch
+    *
+    **/
+    template <typename GraphT>
+    void apply(const GraphT& g, const BatchResult& batch) {
+        unordered_set<NodeID> reread;
+        for (const auto& e : batch.removed) {
+            reread.insert(e.first);
+            reread.insert(e.second);
+        }
+        for (NodeID u : reread) rebuild_node(g, u);
+        for (const auto& e : batch.inserted) {
+            if (!reread.count(e.first)) insert_neighbor(e.first, e.second);
+            if (!reread.count(e.second)) insert_neighbor(e.second, e.first);
+        }
+    }
+
+    bool contains(NodeID u) const {
+        return signatures.count(u) > 0;
+    }
+
+    size_t degree(NodeID u) const {
+        auto it = signatures.find(u);
+        return it != signatures.end() ? it->second.degree : 0;
+    }
+
+    // b-bit estimate: matching low bytes, corrected for the 1/256 chance collision
+    double estimate_jaccard(NodeID u, NodeID v) const {
+        auto iu = signatures.find(u), iv = signatures.find(v);
+        if (iu == signatures.end() || iv == signatures.end()) return 0.0;
+        int matches = count_matches(iu->second.low_bits.data(),
+                                    iv->second.low_bits.data(), num_hashes);
+        const double COLLISION = 1.0 / 256.0;
+        double p = (double)matches / num_hashes;
+        return max(0.0, min(1.0, (p - COLLISION) / (1.0 - COLLISION)));
+    }
+
+    // |N(u) ∩ N(v)| recovered from J = c / (du + dv - c)
+    double estimate_common_neighbors(NodeID u, NodeID v) const {
+        double j = estimate_jaccard(u, v);
+        return j * (degree(u) + degree(v)) / (1.0 + j);
+    }
+
+    /**
+    *@brief: nodes sharing at least one LSH band with u, most similar first
+    *
+    *@param: max_bucket_scan: nodes read per bucket, bounds the cost for hub buckets
+    *@return: (node, estimated Jaccard) pairs, at most max_candidates of them
+    *
+    **/
+    vector<pair<NodeID, double>> similar_nodes(NodeID u, size_t max_candidates = 200,
+                                               size_t max_bucket_scan = 64) const {
+        vector<pair<NodeID, double>> result;
+        auto it = signatures.find(u);
+        if (it == signatures.end()) return result;
+
+        unordered_set<NodeID> seen;
+        for (int b = 0; b < num_bands; ++b) {
+            auto bucket = buckets[b].find(it->second.band_keys[b]);
+            if (bucket == buckets[b].end()) continue;
+            size_t scanned = 0;
+            for (NodeID v : bucket->second) {
+                if (scanned++ >= max_bucket_scan) break;
+                if (v != u && seen.insert(v).second) {
+                    result.push_back({v, estimate_jaccard(u, v)});
+                }
+            }
+        }
+
+        sort(result.begin(), result.end(), [](const pair<NodeID, double>& a,
+                                              const pair<NodeID, double>& b) {
+            return a.second != b.second ? a.second > b.second : a.first < b.first;
+        });
+        if (result.size() > max_candidates) result.resize(max_candidates);
+        return result;
+    }
+
+    size_t size() const {
+        return signatures.size();
+    }
+
+    // Signatures and band buckets, counting one pointer of hash node overhead per entry
+    size_t memory_bytes() const {
+        size_t bytes = seeds.capacity() * sizeof(uint64_t);
+        bytes += signatures.bucket_count() * sizeof(void*);
+        for (const auto& p : signatures) {
+            bytes += sizeof(void*) + sizeof(p) + p.second.mins.capacity() * sizeof(uint32_t) +
+                     p.second.low_bits.capacity() + p.second.band_keys.capacity() * sizeof(uint64_t);
+        }
+        for (const auto& band : buckets) {
+            bytes += band.bucket_count() * sizeof(void*);
+            for (const auto& b : band) {
+                bytes += sizeof(void*) + sizeof(b) + b.second.capacity() * sizeof(NodeID);
+            }
+        }
+        return bytes;
+    }
+};
+
+/**
+* @brief: friend recommendations scored from the sketch index
+*
+* Cost per query is fixed by the band count, bucket scan limit and signature
+* length, plus one has_edge() check per candidate to drop existing friends.
+* Jaccard and common-neighbour counts are sketch estimates; Adamic-Adar needs
+* the exact intersection and is left at 0, so combined_score is the Jaccard and
+* influence terms of FriendRecommendation's blend.
+*
+**/
+class SketchRecommendation {
+public:
+    template <typename GraphT>
+    static vector<RecommendationScore> get_recommendations(
+        const GraphT& g, const MinHashIndex& index, NodeID user, int max_recs = 10,
+        size_t max_candidates = 200) {
+
+        vector<RecommendationScore> recommendations;
+        for (const auto& c : index.similar_nodes(user, max_candidates)) {
+            if (c.second <= 0.0 || g.has_edge(user, c.first)) continue;
+            RecommendationScore score;
+            score.candidate_id = c.first;
+            score.jaccard_score = c.second;
+            score.common_neighbors_count = (int)(index.estimate_common_neighbors(user, c.first) + 0.5);
+            score.influence_potential = calculate_influence_probability(
+                score.common_neighbors_count);
+            score.combined_score = 0.3 * score.jaccard_score +
+                                   0.2 * score.influence_potential;
+            recommendations.push_back(score);
+        }
+
+        sort(recommendations.begin(), recommendations.end(),
+             [](const RecommendationScore& a, const RecommendationScore& b) {
+                 return a.combined_score > b.combined_score;
+             });
+
+        if (recommendations.size() > (size_t)max_recs) {
+            recommendations.resize(max_recs);
+        }
+        return recommendations;
+    }
+};
+
+#endif
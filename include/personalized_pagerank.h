@@ -0,0 +1,271 @@
+#ifndef PERSONALIZED_PAGERANK_H
+#define PERSONALIZED_PAGERANK_H
+
+#include "data_loader.h"
+#include "integrated_social_network.h"
+#include <vector>
+#include <algorithm>
+#include <thread>
+#include <cmath>
+
+using namespace std;
+
+// PERSONALIZED PAGERANK RECOMMENDATION
+
+/**
+* @brief: Reusable per-thread buffers for one local-push query
+*
+* Arrays are sized to the whole graph once; a query only writes the entries it
+* touches and reset() clears exactly those, so repeated queries cost the work
+* they do rather than O(N).
+*
+* @var: p: approximate PPR estimate per node
+* @var: r: residual mass still to be pushed
+* @var: touched: nodes with p or r written in this query
+*
+**/
+struct PPRWorkspace {
+    vector<double> p;
+    vector<double> r;
+    vector<char> in_queue;
+    vector<char> excluded;
+    vector<int> touched;
+    vector<int> queue;
+
+    void prepare(size_t n) {
+        if (p.size() != n) {
+            p.assign(n, 0.0);
+            r.assign(n, 0.0);
+            in_queue.assign(n, 0);
+            excluded.assign(n, 0);
+            touched.clear();
+        }
+    }
+
+    void touch(int u) {
+        if (p[u] == 0.0 && r[u] == 0.0) touched.push_back(u);
+    }
+
+    size_t memory_bytes() const {
+        return (p.capacity() + r.capacity()) * sizeof(double) + in_queue.capacity() +
+               excluded.capacity() + (touched.capacity() + queue.capacity()) * sizeof(int);
+    }
+
+    void reset() {
+        for (int u : touched) {
+            p[u] = 0.0;
+            r[u] = 0.0;
+            in_queue[u] = 0;
+        }
+        touched.clear();
+        queue.clear();
+    }
+};
+
+/**
+* @brief: Approximate personalized PageRank by forward local push (Andersen-Chung-Lang)
+*
+* A node is pushed while its residual is at least epsilon * degree, so total work
+* is O(1 / (alpha * epsilon)) edge visits no matter how large the graph is, and
+* candidates at any hop distance can be reached.
+*
+* @var: alpha: teleport (restart) probability
+* @var: epsilon: residual threshold per unit of degree
+*
+**/
+class PersonalizedPageRank {
+private:
+    vector<NodeID> ids;           // sorted, dense index -> node ID
+    vector<size_t> offsets;
+    vector<int> targets;          // sorted, de-duplicated neighbour indices
+    double alpha;
+    double epsilon;
+
+    int index_of(NodeID node) const {
+        auto it = lower_bound(ids.begin(), ids.end(), node);
+        if (it == ids.end() || *it != node) return -1;
+        return it - ids.begin();
+    }
+
+    size_t degree(int u) const {
+        return offsets[u + 1] - offsets[u];
+    }
+
+    void push(int source, PPRWorkspace& ws) const {
+        ws.prepare(ids.size());
+        ws.reset();
+        ws.touch(source);
+        ws.r[source] = 1.0;
+        ws.queue.push_back(source);
+        ws.in_queue[source] = 1;
+
+        for (size_t head = 0; head < ws.queue.size(); ++head) {
+            int u = ws.queue[head];
+            ws.in_queue[u] = 0;
+            double ru = ws.r[u];
+            size_t du = degree(u);
+            if (du == 0) {
+                ws.p[u] += ru;
+                ws.r[u] = 0.0;
+                continue;
+            }
+            if (ru < epsilon * du) continue;
+
+            ws.p[u] += alpha * ru;
+            ws.r[u] = 0.0;
+            double share = (1.0 - alpha) * ru / du;
+            for (size_t e = offsets[u]; e < offsets[u + 1]; ++e) {
+                int v = targets[e];
+                ws.touch(v);
+                ws.r[v] += share;
+                if (!ws.in_queue[v] && ws.r[v] >= epsilon * degree(v)) {
+                    ws.in_queue[v] = 1;
+                    ws.queue.push_back(v);
+                }
+            }
+        }
+    }
+
+    // Exact overlap measures from the sorted lists, only run for final results
+    void fill_similarity(int u, int v, RecommendationScore& score) const {
+        size_t i = offsets[u], j = offsets[v];
+        int common = 0;
+        double adamic_adar = 0.0;
+        while (i < offsets[u + 1] && j < offsets[v + 1]) {
+            if (targets[i] < targets[j]) ++i;
+            else if (targets[i] > targets[j]) ++j;
+            else {
+                size_t dw = degree(targets[i]);
+                if (dw > 1) adamic_adar += 1.0 / log(dw);
+                ++common;
+                ++i;
+                ++j;
+            }
+        }
+        size_t union_size = degree(u) + degree(v) - common;
+        score.common_neighbors_count = common;
+        score.jaccard_score = union_size > 0 ? (double)common / union_size : 0.0;
+        score.adamic_adar_score = adamic_adar;
+        score.influence_potential = calculate_influence_probability(common);
+    }
+
+public:
+    template <typename GraphT>
+    explicit PersonalizedPageRank(const GraphT& g, double alpha = 0.15, double epsilon = 1e-4)
+        : alpha(alpha), epsilon(epsilon) {
+        for (const auto& p : g.get_adj_list()) ids.push_back(p.first);
+        sort(ids.begin(), ids.end());
+
+        offsets.assign(1, 0);
+        vector<int> list;
+        for (NodeID id : ids) {
+            list.clear();
+            for (const auto& edge : g.get_neighbors(id)) {
+                int v = index_of(edge.target);
+                if (v >= 0 && edge.target != id) list.push_back(v);
+            }
+            sort(list.begin(), list.end());
+            list.erase(unique(list.begin(), list.end()), list.end());
+            targets.insert(targets.end(), list.begin(), list.end());
+            offsets.push_back(targets.size());
+        }
+    }
+
+    // PPR estimates of every node the push reached, by node ID
+    vector<pair<NodeID, double>> scores(NodeID user, PPRWorkspace& ws) const {
+        vector<pair<NodeID, double>> result;
+        int source = index_of(user);
+        if (source < 0) return result;
+        push(source, ws);
+        for (int u : ws.touched) {
+            if (ws.p[u] > 0.0) result.push_back({ids[u], ws.p[u]});
+        }
+        return result;
+    }
+
+    /**
+    *@brief: ranks non-friends by PPR mass divided by their degree
+    *
+    *@return: recommendations with ppr_score set to the raw estimate and
+    *         combined_score to the degree-normalised one that keeps hubs from
+    *         dominating; overlap fields are exact for the returned candidates
+    *
+    **/
+    vector<RecommendationScore> recommend(NodeID user, int max_recs, PPRWorkspace& ws) const {
+        vector<RecommendationScore> recommendations;
+        int source = index_of(user);
+        if (source < 0) return recommendations;
+        push(source, ws);
+
+        ws.excluded[source] = 1;
+        for (size_t e = offsets[source]; e < offsets[source + 1]; ++e) ws.excluded[targets[e]] = 1;
+
+        vector<pair<double, int>> ranked;
+        for (int u : ws.touched) {
+            if (!ws.excluded[u] && ws.p[u] > 0.0) {
+                ranked.push_back({ws.p[u] / max<size_t>(1, degree(u)), u});
+            }
+        }
+
+        ws.excluded[source] = 0;
+        for (size_t e = offsets[source]; e < offsets[source + 1]; ++e) ws.excluded[targets[e]] = 0;
+
+        size_t k = min(ranked.size(), (size_t)max(0, max_recs));
+        partial_sort(ranked.begin(), ranked.begin() + k, ranked.end(),
+                     [](const pair<double, int>& a, const pair<double, int>& b) {
+                         return a.first != b.first ? a.first > b.first : a.second < b.second;
+                     });
+
+        for (size_t i = 0; i < k; ++i) {
+            int v = ranked[i].second;
+            RecommendationScore score;
+            score.candidate_id = ids[v];
+            score.ppr_score = ws.p[v];
+            score.combined_score = ranked[i].first;
+            fill_similarity(source, v, score);
+            recommendations.push_back(score);
+        }
+        return recommendations;
+    }
+
+    vector<RecommendationScore> recommend(NodeID user, int max_recs = 10) const {
+        PPRWorkspace ws;
+        return recommend(user, max_recs, ws);
+    }
+
+    // Adjacency held by this object; the sorted IDs and the CSR of neighbour indices
+    size_t memory_bytes() const {
+        return ids.capacity() * sizeof(NodeID) + offsets.capacity() * sizeof(size_t) +
+               targets.capacity() * sizeof(int);
+    }
+
+    // Dense arrays a workspace holds once it has served a query on this graph
+    size_t workspace_bytes() const {
+        return ids.size() * (2 * sizeof(double) + 2);
+    }
+
+    // Users are split across threads, each reusing one workspace for all its queries,
+    // so the batch holds num_threads * workspace_bytes() on top of the adjacency
+    vector<vector<RecommendationScore>> recommend_batch(const vector<NodeID>& users,
+                                                        int max_recs = 10,
+                                                        int num_threads = 0) const {
+        vector<vector<RecommendationScore>> results(users.size());
+        if (num_threads <= 0) num_threads = max(1u, thread::hardware_concurrency());
+        num_threads = (int)min<size_t>(num_threads, max<size_t>(1, users.size()));
+
+        auto worker = [&](int t) {
+            PPRWorkspace ws;
+            for (size_t i = t; i < users.size(); i += num_threads) {
+                results[i] = recommend(users[i], max_recs, ws);
+            }
+        };
+
+        vector<thread> threads;
+        for (int t = 1; t < num_threads; ++t) threads.emplace_back(worker, t);
+        worker(0);
+        for (auto& th : threads) th.join();
+        return results;
+    }
+};
+
+#endif
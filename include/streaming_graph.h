@@ -0,0 +1,422 @@
+#ifndef STREAMING_GRAPH_H
+#define STREAMING_GRAPH_H
+
+#include "data_loader.h"
+#include "integrated_social_network.h"
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <memory>
+#include <mutex>
+#include <algorithm>
+#include <cstdint>
+
+using namespace std;
+
+// STREAMING GRAPH
+
+struct EdgeUpdate {
+    enum Type { INSERT, REMOVE };
+    Type type;
+    NodeID u;
+    NodeID v;
+};
+
+/**
+* @brief: What one apply_batch() call actually changed
+*
+* @var: inserted / removed: edges that changed the graph, as (min, max) pairs
+* @var: ignored: duplicates, self loops and removals of missing edges
+*
+**/
+struct BatchResult {
+    uint64_t version = 0;
+    vector<pair<NodeID, NodeID>> inserted;
+    vector<pair<NodeID, NodeID>> removed;
+    size_t ignored = 0;
+};
+
+struct StreamingStats {
+    long long num_nodes = 0;
+    long long num_edges = 0;
+    size_t max_degree = 0;
+    map<size_t, long long> degree_histogram;   // degree -> number of nodes
+
+    double average_degree() const {
+        return num_nodes > 0 ? 2.0 * num_edges / num_nodes : 0.0;
+    }
+};
+
+/**
+* @brief: Immutable version of a streaming graph
+*
+* Nodes are hashed into small blocks, each a map from node to a shared,
+* read-only neighbour list. A batch copies the lists it changes and the blocks
+* holding them; everything else is shared with the previous version, so a
+* reader holding a snapshot keeps a consistent graph while new versions are
+* published. Blocks hold a few dozen nodes, as the block count doubles with
+* the node count.
+* Neighbour lists are sorted by target. Every edge carries its common-neighbour
+* count, and its probability is calculate_influence_probability() of that count.
+* The iteration interface matches Graph, so the templated algorithms run on it.
+*
+**/
+class GraphSnapshot {
+    friend class StreamingGraph;
+
+public:
+    struct NodeList {
+        vector<InfluenceEdge> edges;
+        vector<int> common;   // parallel to edges
+    };
+
+    struct Block {
+        map<NodeID, shared_ptr<const NodeList>> nodes;
+    };
+
+    class NodeIterator {
+    private:
+        const vector<shared_ptr<const Block>>* blocks;
+        size_t block;
+        map<NodeID, shared_ptr<const NodeList>>::const_iterator it;
+
+        void skip_empty() {
+            while (block < blocks->size() && it == (*blocks)[block]->nodes.end()) {
+                if (++block < blocks->size()) it = (*blocks)[block]->nodes.begin();
+            }
+        }
+
+    public:
+        NodeIterator(const vector<shared_ptr<const Block>>* b, size_t i) : blocks(b), block(i) {
+            if (block < blocks->size()) {
+                it = (*blocks)[block]->nodes.begin();
+                skip_empty();
+            }
+        }
+
+        pair<NodeID, const vector<InfluenceEdge>&> operator*() const {
+            return {it->first, it->second->edges};
+        }
+
+        struct ArrowProxy {
+            pair<NodeID, const vector<InfluenceEdge>&> value;
+            const pair<NodeID, const vector<InfluenceEdge>&>* operator->() const { return &value; }
+        };
+        ArrowProxy operator->() const { return {**this}; }
+
+        NodeIterator& operator++() {
+            ++it;
+            skip_empty();
+            return *this;
+        }
+
+        bool operator==(const NodeIterator& other) const {
+            return block == other.block && (block == blocks->size() || it == other.it);
+        }
+        bool operator!=(const NodeIterator& other) const { return !(*this == other); }
+    };
+
+    class NodeRange {
+    private:
+        const GraphSnapshot* g;
+
+    public:
+        explicit NodeRange(const GraphSnapshot* graph) : g(graph) {}
+
+        NodeIterator begin() const { return NodeIterator(&g->blocks, 0); }
+        NodeIterator end() const { return NodeIterator(&g->blocks, g->blocks.size()); }
+        size_t size() const { return g->stats.num_nodes; }
+        bool empty() const { return g->stats.num_nodes == 0; }
+        size_t count(NodeID node) const { return g->list_of(node) ? 1 : 0; }
+    };
+
+private:
+    uint64_t version_number = 0;
+    vector<shared_ptr<const Block>> blocks;
+    StreamingStats stats;
+
+    static size_t block_index(NodeID node, size_t num_blocks) {
+        return (size_t)(((uint64_t)(uint32_t)node * 0x9E3779B97F4A7C15ULL) >> 32) % num_blocks;
+    }
+
+    size_t block_index(NodeID node) const {
+        return block_index(node, blocks.size());
+    }
+
+    const NodeList* list_of(NodeID node) const {
+        const auto& nodes = blocks[block_index(node)]->nodes;
+        auto it = nodes.find(node);
+        return it != nodes.end() ? it->second.get() : nullptr;
+    }
+
+public:
+    NodeRange get_adj_list() const {
+        return NodeRange(this);
+    }
+
+    const vector<InfluenceEdge>& get_neighbors(NodeID node) const {
+        const NodeList* list = list_of(node);
+        if (list) return list->edges;
+        static const vector<InfluenceEdge> empty_vec;
+        return empty_vec;
+    }
+
+    bool has_edge(NodeID u, NodeID v) const {
+        const auto& list = get_neighbors(u);
+        auto it = lower_bound(list.begin(), list.end(), v,
+                              [](const InfluenceEdge& e, NodeID t) { return e.target < t; });
+        return it != list.end() && it->target == v;
+    }
+
+    // Maintained count, -1 if the edge does not exist
+    int common_neighbors(NodeID u, NodeID v) const {
+        const NodeList* list = list_of(u);
+        if (!list) return -1;
+        auto pos = lower_bound(list->edges.begin(), list->edges.end(), v,
+                               [](const InfluenceEdge& e, NodeID t) { return e.target < t; });
+        if (pos == list->edges.end() || pos->target != v) return -1;
+        return list->common[pos - list->edges.begin()];
+    }
+
+    uint64_t version() const {
+        return version_number;
+    }
+
+    const StreamingStats& statistics() const {
+        return stats;
+    }
+
+    NodeID original_id(NodeID node) const {
+        return node;
+    }
+
+    NodeID internal_id(NodeID original) const {
+        return original;
+    }
+};
+
+/**
+* @brief: Graph that takes batches of edge inserts and deletes while readers
+*         keep working on earlier snapshots
+*
+* Writers are serialised; each batch builds the next GraphSnapshot and
+* publishes it in one pointer swap. Degrees, per-edge common-neighbour counts,
+* influence probabilities and StreamingStats are patched incrementally: an
+* insert or delete of (u, v) only revisits the edges from u and v to their
+* common neighbours, and only those lists are copied.
+*
+**/
+class StreamingGraph {
+private:
+    static const size_t NODES_PER_BLOCK = 32;
+
+    shared_ptr<const GraphSnapshot> current;
+    mutable mutex snapshot_mutex;
+    mutex writer_mutex;
+
+    // Copy-on-write state for the batch being applied
+    struct Draft {
+        GraphSnapshot* next;
+        vector<shared_ptr<GraphSnapshot::Block>> owned;                // blocks cloned by this batch
+        unordered_map<NodeID, shared_ptr<GraphSnapshot::NodeList>> lists;   // lists cloned by this batch
+
+        GraphSnapshot::Block& block(NodeID node) {
+            size_t i = next->block_index(node);
+            if (!owned[i]) {
+                owned[i] = make_shared<GraphSnapshot::Block>(*next->blocks[i]);
+                next->blocks[i] = owned[i];
+            }
+            return *owned[i];
+        }
+
+        // Writable list of node, created empty if the node is new
+        GraphSnapshot::NodeList& list(NodeID node) {
+            auto it = lists.find(node);
+            if (it != lists.end()) return *it->second;
+            auto& slot = block(node).nodes[node];
+            auto copy = slot ? make_shared<GraphSnapshot::NodeList>(*slot)
+                             : make_shared<GraphSnapshot::NodeList>();
+            slot = copy;
+            lists[node] = copy;
+            return *copy;
+        }
+
+        void erase(NodeID node) {
+            block(node).nodes.erase(node);
+            lists.erase(node);
+        }
+    };
+
+    static size_t find_entry(const vector<InfluenceEdge>& list, NodeID target) {
+        auto it = lower_bound(list.begin(), list.end(), target,
+                              [](const InfluenceEdge& e, NodeID t) { return e.target < t; });
+        return it - list.begin();
+    }
+
+    static vector<NodeID> common_of(const GraphSnapshot& g, NodeID u, NodeID v) {
+        const auto& a = g.get_neighbors(u);
+        const auto& b = g.get_neighbors(v);
+        vector<NodeID> result;
+        size_t i = 0, j = 0;
+        while (i < a.size() && j < b.size()) {
+            if (a[i].target < b[j].target) ++i;
+            else if (a[i].target > b[j].target) ++j;
+            else {
+                result.push_back(a[i].target);
+                ++i;
+                ++j;
+            }
+        }
+        return result;
+    }
+
+    static void change_degree(StreamingStats& stats, size_t from, size_t to) {
+        if (from > 0 && --stats.degree_histogram[from] == 0) stats.degree_histogram.erase(from);
+        if (to > 0) stats.degree_histogram[to]++;
+        if (from == 0) stats.num_nodes++;
+        if (to == 0) stats.num_nodes--;
+        stats.max_degree = stats.degree_histogram.empty() ? 0 : stats.degree_histogram.rbegin()->first;
+    }
+
+    // Adjusts the common-neighbour count of the existing edge u -> w by delta
+    static void adjust_common(Draft& d, NodeID u, NodeID w, int delta) {
+        auto& list = d.list(u);
+        size_t i = find_entry(list.edges, w);
+        list.common[i] += delta;
+        list.edges[i].probability = calculate_influence_probability(list.common[i]);
+    }
+
+    static void insert_entry(Draft& d, NodeID u, NodeID v, int common_count) {
+        auto& list = d.list(u);
+        size_t old_degree = list.edges.size();
+        size_t i = find_entry(list.edges, v);
+        list.edges.insert(list.edges.begin() + i, {v, calculate_influence_probability(common_count)});
+        list.common.insert(list.common.begin() + i, common_count);
+        change_degree(d.next->stats, old_degree, list.edges.size());
+    }
+
+    static void erase_entry(Draft& d, NodeID u, NodeID v) {
+        auto& list = d.list(u);
+        size_t old_degree = list.edges.size();
+        size_t i = find_entry(list.edges, v);
+        list.edges.erase(list.edges.begin() + i);
+        list.common.erase(list.common.begin() + i);
+        change_degree(d.next->stats, old_degree, list.edges.size());
+        if (list.edges.empty()) d.erase(u);
+    }
+
+    // Doubles the block count once blocks average more than NODES_PER_BLOCK nodes;
+    // lists are shared, so this copies one pointer per node
+    static void grow_blocks(GraphSnapshot& g) {
+        size_t count = g.blocks.size();
+        while ((size_t)g.stats.num_nodes > count * NODES_PER_BLOCK) count *= 2;
+        if (count == g.blocks.size()) return;
+
+        vector<shared_ptr<GraphSnapshot::Block>> grown(count);
+        for (auto& b : grown) b = make_shared<GraphSnapshot::Block>();
+        for (const auto& block : g.blocks) {
+            for (const auto& p : block->nodes) {
+                grown[GraphSnapshot::block_index(p.first, count)]->nodes.insert(p);
+            }
+        }
+        g.blocks.assign(grown.begin(), grown.end());
+    }
+
+    static void insert_edge(Draft& d, NodeID u, NodeID v) {
+        vector<NodeID> shared = common_of(*d.next, u, v);
+        for (NodeID w : shared) {
+            adjust_common(d, u, w, +1);
+            adjust_common(d, w, u, +1);
+            adjust_common(d, v, w, +1);
+            adjust_common(d, w, v, +1);
+        }
+        insert_entry(d, u, v, shared.size());
+        insert_entry(d, v, u, shared.size());
+        d.next->stats.num_edges++;
+    }
+
+    static void remove_edge(Draft& d, NodeID u, NodeID v) {
+        vector<NodeID> shared = common_of(*d.next, u, v);
+        for (NodeID w : shared) {
+            adjust_common(d, u, w, -1);
+            adjust_common(d, w, u, -1);
+            adjust_common(d, v, w, -1);
+            adjust_common(d, w, v, -1);
+        }
+        erase_entry(d, u, v);
+        erase_entry(d, v, u);
+        d.next->stats.num_edges--;
+    }
+
+public:
+    // num_blocks is the starting block count; it grows with the graph
+    explicit StreamingGraph(size_t num_blocks = 64) {
+        auto empty = make_shared<GraphSnapshot>();
+        auto block = make_shared<const GraphSnapshot::Block>();
+        empty->blocks.assign(max<size_t>(1, num_blocks), block);
+        current = empty;
+    }
+
+    // Latest published version; stays valid and unchanged for as long as it is held
+    shared_ptr<const GraphSnapshot> snapshot() const {
+        lock_guard<mutex> lock(snapshot_mutex);
+        return current;
+    }
+
+    /**
+    *@brief: applies the updates in order and publishes the result as one new version
+    *
+    *@return: the edges that changed; inserts of existing edges, deletes of missing
+    *         ones and self loops are counted in ignored
+    *
+    **/
+    BatchResult apply_batch(const vector<EdgeUpdate>& batch) {
+        lock_guard<mutex> writer(writer_mutex);
+        auto base = snapshot();
+        auto next = make_shared<GraphSnapshot>(*base);
+        Draft draft{next.get(), vector<shared_ptr<GraphSnapshot::Block>>(next->blocks.size()), {}};
+
+        BatchResult result;
+        for (const auto& update : batch) {
+            NodeID u = min(update.u, update.v);
+            NodeID v = max(update.u, update.v);
+            bool exists = next->has_edge(u, v);
+            if (u == v || (update.type == EdgeUpdate::INSERT) == exists) {
+                result.ignored++;
+                continue;
+            }
+            if (update.type == EdgeUpdate::INSERT) {
+                insert_edge(draft, u, v);
+                result.inserted.push_back({u, v});
+            } else {
+                remove_edge(draft, u, v);
+                result.removed.push_back({u, v});
+            }
+        }
+
+        grow_blocks(*next);
+        next->version_number = base->version_number + 1;
+        result.version = next->version_number;
+        {
+            lock_guard<mutex> lock(snapshot_mutex);
+            current = next;
+        }
+        return result;
+    }
+
+    BatchResult insert_edges(const vector<pair<NodeID, NodeID>>& edges) {
+        vector<EdgeUpdate> batch;
+        batch.reserve(edges.size());
+        for (const auto& e : edges) batch.push_back({EdgeUpdate::INSERT, e.first, e.second});
+        return apply_batch(batch);
+    }
+
+    BatchResult remove_edges(const vector<pair<NodeID, NodeID>>& edges) {
+        vector<EdgeUpdate> batch;
+        batch.reserve(edges.size());
+        for (const auto& e : edges) batch.push_back({EdgeUpdate::REMOVE, e.first, e.second});
+        return apply_batch(batch);
+    }
+};
+
+#endif
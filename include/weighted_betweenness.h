@@ -0,0 +1,375 @@
+#ifndef WEIGHTED_BETWEENNESS_H
+#define WEIGHTED_BETWEENNESS_H
+
+#include "data_loader.h"
+#include "integrated_social_network.h"
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <thread>
+#include <limits>
+#include <cmath>
+#include <cstdint>
+
+using namespace std;
+
+// WEIGHTED BETWEENNESS CENTRALITY
+
+/**
+* @brief: Monotone priority queue for integer keys (radix heap)
+*
+* Keys may never be smaller than the last popped key, which always holds for
+* Dijkstra. Bucket i holds keys whose highest bit differing from the last
+* popped key is i - 1, so each element moves down at most 64 times.
+*
+**/
+class RadixHeap {
+private:
+    vector<pair<uint64_t, int>> buckets[65];
+    uint64_t last = 0;
+    size_t count = 0;
+
+    static int bucket_of(uint64_t key, uint64_t last) {
+        return key == last ? 0 : 64 - __builtin_clzll(key ^ last);
+    }
+
+public:
+    bool empty() const { return count == 0; }
+
+    void clear() {
+        for (auto& b : buckets) b.clear();
+        last = 0;
+        count = 0;
+    }
+
+    void push(uint64_t key, int value) {
+        buckets[bucket_of(key, last)].push_back({key, value});
+        count++;
+    }
+
+    pair<uint64_t, int> pop() {
+        if (buckets[0].empty()) {
+            int i = 1;
+            while (buckets[i].empty()) ++i;
+            uint64_t new_last = buckets[i][0].first;
+            for (const auto& e : buckets[i]) new_last = min(new_last, e.first);
+            for (const auto& e : buckets[i]) buckets[bucket_of(e.first, new_last)].push_back(e);
+            buckets[i].clear();
+            last = new_last;
+        }
+        auto top = buckets[0].back();
+        buckets[0].pop_back();
+        count--;
+        return top;
+    }
+};
+
+// Min-heap with D children per node; shallower than a binary heap, so fewer cache misses on pop
+template <int D = 4>
+class DaryHeap {
+private:
+    vector<pair<double, int>> heap;
+
+public:
+    bool empty() const { return heap.empty(); }
+    void clear() { heap.clear(); }
+
+    void push(double key, int value) {
+        size_t i = heap.size();
+        heap.push_back({key, value});
+        while (i > 0) {
+            size_t parent = (i - 1) / D;
+            if (heap[parent].first <= heap[i].first) break;
+            swap(heap[parent], heap[i]);
+            i = parent;
+        }
+    }
+
+    pair<double, int> pop() {
+        auto top = heap[0];
+        heap[0] = heap.back();
+        heap.pop_back();
+        size_t i = 0, n = heap.size();
+        while (true) {
+            size_t first = D * i + 1;
+            if (first >= n) break;
+            size_t best = first;
+            for (size_t c = first + 1; c < min(first + D, n); ++c) {
+                if (heap[c].first < heap[best].first) best = c;
+            }
+            if (heap[i].first <= heap[best].first) break;
+            swap(heap[i], heap[best]);
+            i = best;
+        }
+        return top;
+    }
+};
+
+// Every edge has length 1, which gives the same scores as BetweennessCentrality
+struct UnitDistance {
+    template <typename GraphT>
+    double operator()(const GraphT&, NodeID, const InfluenceEdge&) const {
+        return 1.0;
+    }
+};
+
+// -log(p) of the probability stored on the edge; edges with p <= 0 are unusable
+struct EdgeProbabilityDistance {
+    template <typename GraphT>
+    double operator()(const GraphT&, NodeID, const InfluenceEdge& edge) const {
+        if (edge.probability <= 0.0) return numeric_limits<double>::infinity();
+        return -log(min(1.0, edge.probability));
+    }
+};
+
+// -log(p) of the ICM probability, derived from common neighbours like simulate_ICM
+struct InfluenceProbabilityDistance {
+    template <typename GraphT>
+    double operator()(const GraphT& g, NodeID u, const InfluenceEdge& edge) const {
+        double p = calculate_influence_probability(count_common_neighbors(g, u, edge.target));
+        if (p <= 0.0) return numeric_limits<double>::infinity();
+        return -log(p);
+    }
+};
+
+/**
+* @var: quantum: if > 0, weights are rounded to multiples of it and the radix heap
+*                is used; otherwise weights stay doubles in a 4-ary heap
+* @var: epsilon: relative tolerance for treating two path lengths as equal
+* @var: min_weight: floor for edge lengths; zero-length edges would let nodes at
+*                  equal distance settle before all their shortest paths are counted
+* @var: num_threads: sources are split across this many threads (0 = all cores)
+*
+**/
+struct WeightedBCOptions {
+    double quantum = 0.0;
+    double epsilon = 1e-9;
+    double min_weight = 1e-6;
+    int num_threads = 1;
+};
+
+class WeightedBetweennessCentrality {
+private:
+    struct WeightedCSR {
+        vector<NodeID> ids;
+        vector<size_t> offsets;
+        vector<int> targets;
+        vector<double> weights;
+        vector<uint64_t> int_weights;
+    };
+
+    // Per-thread buffers; predecessors of v live in pred[offsets[v] ..]
+    struct Workspace {
+        vector<double> dist;
+        vector<uint64_t> int_dist;
+        vector<double> sigma;
+        vector<double> delta;
+        vector<int> pred;
+        vector<int> pred_count;
+        vector<char> settled;
+        vector<int> order;
+        RadixHeap radix;
+        DaryHeap<4> dary;
+
+        explicit Workspace(const WeightedCSR& csr)
+            : dist(csr.ids.size()), int_dist(csr.ids.size()), sigma(csr.ids.size()),
+              delta(csr.ids.size()), pred(csr.targets.size()), pred_count(csr.ids.size()),
+              settled(csr.ids.size()) {}
+    };
+
+    template <typename GraphT, typename WeightFn>
+    static WeightedCSR build_csr(const GraphT& g, const WeightFn& weight,
+                                 const WeightedBCOptions& options) {
+        WeightedCSR csr;
+        for (const auto& p : g.get_adj_list()) csr.ids.push_back(p.first);
+        sort(csr.ids.begin(), csr.ids.end());
+        unordered_map<NodeID, int> index;
+        for (size_t i = 0; i < csr.ids.size(); ++i) index[csr.ids[i]] = i;
+
+        csr.offsets.push_back(0);
+        for (NodeID u : csr.ids) {
+            for (const auto& edge : g.get_neighbors(u)) {
+                double w = weight(g, u, edge);
+                if (!isfinite(w)) continue;
+                w = max(w, options.min_weight);
+                csr.targets.push_back(index[edge.target]);
+                csr.weights.push_back(w);
+                csr.int_weights.push_back(options.quantum > 0.0
+                                          ? max<uint64_t>(1, llround(w / options.quantum)) : 0);
+            }
+            csr.offsets.push_back(csr.targets.size());
+        }
+        return csr;
+    }
+
+    static void add_predecessor(Workspace& ws, const WeightedCSR& csr, int v, int u, bool reset) {
+        if (reset) ws.pred_count[v] = 0;
+        ws.pred[csr.offsets[v] + ws.pred_count[v]++] = u;
+    }
+
+    // Dijkstra phase with exact integer distances and the radix heap
+    static void shortest_paths_quantized(const WeightedCSR& csr, int s, Workspace& ws) {
+        const uint64_t INF = numeric_limits<uint64_t>::max();
+        fill(ws.int_dist.begin(), ws.int_dist.end(), INF);
+        ws.int_dist[s] = 0;
+        ws.sigma[s] = 1.0;
+        ws.radix.clear();
+        ws.radix.push(0, s);
+
+        while (!ws.radix.empty()) {
+            auto top = ws.radix.pop();
+            int u = top.second;
+            if (ws.settled[u] || top.first > ws.int_dist[u]) continue;
+            ws.settled[u] = 1;
+            ws.order.push_back(u);
+
+            for (size_t e = csr.offsets[u]; e < csr.offsets[u + 1]; ++e) {
+                int v = csr.targets[e];
+                uint64_t alt = ws.int_dist[u] + csr.int_weights[e];
+                if (alt < ws.int_dist[v]) {
+                    ws.int_dist[v] = alt;
+                    ws.sigma[v] = ws.sigma[u];
+                    add_predecessor(ws, csr, v, u, true);
+                    ws.radix.push(alt, v);
+                } else if (alt == ws.int_dist[v] && !ws.settled[v]) {
+                    ws.sigma[v] += ws.sigma[u];
+                    add_predecessor(ws, csr, v, u, false);
+                }
+            }
+        }
+    }
+
+    // Dijkstra phase on doubles; lengths within epsilon count as the same shortest path
+    static void shortest_paths_real(const WeightedCSR& csr, int s, Workspace& ws, double epsilon) {
+        const double INF = numeric_limits<double>::infinity();
+        fill(ws.dist.begin(), ws.dist.end(), INF);
+        ws.dist[s] = 0.0;
+        ws.sigma[s] = 1.0;
+        ws.dary.clear();
+        ws.dary.push(0.0, s);
+
+        while (!ws.dary.empty()) {
+            auto top = ws.dary.pop();
+            int u = top.second;
+            if (ws.settled[u] || top.first > ws.dist[u]) continue;
+            ws.settled[u] = 1;
+            ws.order.push_back(u);
+
+            for (size_t e = csr.offsets[u]; e < csr.offsets[u + 1]; ++e) {
+                int v = csr.targets[e];
+                if (ws.settled[v]) continue;
+                double alt = ws.dist[u] + csr.weights[e];
+                double tolerance = epsilon * max(1.0, alt);
+                if (alt < ws.dist[v] - tolerance) {
+                    ws.dist[v] = alt;
+                    ws.sigma[v] = ws.sigma[u];
+                    add_predecessor(ws, csr, v, u, true);
+                    ws.dary.push(alt, v);
+                } else if (fabs(alt - ws.dist[v]) <= tolerance) {
+                    ws.sigma[v] += ws.sigma[u];
+                    add_predecessor(ws, csr, v, u, false);
+                }
+            }
+        }
+    }
+
+    static void accumulate_source(const WeightedCSR& csr, int s, Workspace& ws,
+                                  const WeightedBCOptions& options, vector<double>& centrality) {
+        fill(ws.sigma.begin(), ws.sigma.end(), 0.0);
+        fill(ws.delta.begin(), ws.delta.end(), 0.0);
+        fill(ws.pred_count.begin(), ws.pred_count.end(), 0);
+        fill(ws.settled.begin(), ws.settled.end(), 0);
+        ws.order.clear();
+
+        if (options.quantum > 0.0) shortest_paths_quantized(csr, s, ws);
+        else shortest_paths_real(csr, s, ws, options.epsilon);
+
+        // dependency accumulation in reverse settle order, as in the unweighted pass
+        for (size_t i = ws.order.size(); i-- > 0;) {
+            int w = ws.order[i];
+            for (int k = 0; k < ws.pred_count[w]; ++k) {
+                int v = ws.pred[csr.offsets[w] + k];
+                ws.delta[v] += (ws.sigma[v] / ws.sigma[w]) * (1.0 + ws.delta[w]);
+            }
+            if (w != s) centrality[w] += ws.delta[w];
+        }
+    }
+
+public:
+    // Peak bytes for n nodes and `entries` adjacency entries (each edge counted from
+    // both ends): the CSR with its index map, plus a workspace and partial scores per thread
+    static size_t estimate_bytes(size_t n, size_t entries, int num_threads) {
+        const size_t HASH_NODE_BYTES = 32;
+        size_t csr = n * (sizeof(NodeID) + sizeof(size_t) + HASH_NODE_BYTES) +
+                     entries * (sizeof(int) + sizeof(double) + sizeof(uint64_t));
+        size_t workspace = n * (sizeof(double) * 3 + sizeof(uint64_t) + sizeof(int) * 2 + sizeof(char)) +
+                           entries * sizeof(int) +
+                           n * 16;   // heap entries
+        size_t partial = n * sizeof(double);
+        return csr + max(1, num_threads) * (workspace + partial);
+    }
+
+    /**
+    *@brief: Brandes betweenness over weighted shortest paths
+    *
+    *@param: weight: maps (graph, u, edge) to a non-negative length; infinite drops the edge
+    *@return: centrality per node, halved like the unweighted version since every
+    *         undirected pair is counted from both ends
+    *
+    **/
+    template <typename GraphT, typename WeightFn = EdgeProbabilityDistance>
+    static unordered_map<NodeID, double> compute_betweenness_centrality(
+        const GraphT& g, const WeightedBCOptions& options = WeightedBCOptions(),
+        const WeightFn& weight = WeightFn()) {
+
+        WeightedCSR csr = build_csr(g, weight, options);
+        size_t n = csr.ids.size();
+
+        int num_threads = options.num_threads;
+        if (num_threads <= 0) num_threads = max(1u, thread::hardware_concurrency());
+        num_threads = (int)min<size_t>(num_threads, max<size_t>(1, n));
+
+        vector<vector<double>> partial(num_threads, vector<double>(n, 0.0));
+        auto worker = [&](int t) {
+            Workspace ws(csr);
+            for (size_t s = t; s < n; s += num_threads) {
+                accumulate_source(csr, s, ws, options, partial[t]);
+            }
+        };
+
+        vector<thread> threads;
+        for (int t = 1; t < num_threads; ++t) threads.emplace_back(worker, t);
+        worker(0);
+        for (auto& th : threads) th.join();
+
+        unordered_map<NodeID, double> centrality_score;
+        for (size_t i = 0; i < n; ++i) {
+            double total = 0.0;
+            for (int t = 0; t < num_threads; ++t) total += partial[t][i];
+            centrality_score[csr.ids[i]] = total / 2.0;
+        }
+        return centrality_score;
+    }
+
+    template <typename GraphT, typename WeightFn = EdgeProbabilityDistance>
+    static vector<NodeID> get_top_k_nodes(const GraphT& g, int k,
+                                          const WeightedBCOptions& options = WeightedBCOptions(),
+                                          const WeightFn& weight = WeightFn()) {
+        auto bc = compute_betweenness_centrality(g, options, weight);
+        vector<pair<double, NodeID>> arr;
+
+        for (const auto& p : bc)
+            arr.push_back({p.second, p.first});
+
+        sort(arr.begin(), arr.end(),
+             [](auto& a, auto& b){ return a.first > b.first; });
+
+        vector<NodeID> res;
+        for (int i = 0; i < min(k, (int)arr.size()); i++)
+            res.push_back(arr[i].second);
+
+        return res;
+    }
+};
+
+#endif
@@ -1,13 +1,56 @@
 #include "../include/data_loader.h"
 #include "../include/integrated_social_network.h"
+#include "../include/graph_reordering.h"
+#include "../include/compressed_graph.h"
+#include "../include/minhash_index.h"
+#include "../include/personalized_pagerank.h"
+#include "../include/weighted_betweenness.h"
+#include "../include/influence_oracle.h"
+#include "../include/batch_analysis.h"
+#include "../include/graph_profile.h"
+#include "../include/memory_accounting.h"
 #include <iostream>
 #include <iomanip>
 #include <fstream>
 #include <sstream>
 #include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <new>
 
 using namespace std;
 
+#if defined(__GLIBC__)
+#include <malloc.h>
+
+// Counting allocator hook for the memory report. glibc knows each block's size, so
+// blocks carry no prefix; the 8-byte chunk header is added as heap_block() counts it.
+void* operator new(size_t size) {
+    void* ptr = malloc(size ? size : 1);
+    if (!ptr) throw bad_alloc();
+    HeapCounter::record_alloc(malloc_usable_size(ptr) + sizeof(size_t));
+    return ptr;
+}
+
+void operator delete(void* ptr) noexcept {
+    if (!ptr) return;
+    HeapCounter::record_free(malloc_usable_size(ptr) + sizeof(size_t));
+    free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    operator delete(ptr);
+}
+#endif
+
+struct Session {
+    string sketch_path;
+    size_t memory_budget_bytes = 0;   // 0 = unlimited
+    MemoryReport structures;          // graph footprint taken at load
+    vector<PhaseUsage> phases;
+};
+
 // Load graph from file
 void load_graph_from_file(Graph& g, const string& filename) {
     const double DEFAULT_PROBABILITY = 0.01;
@@ -18,19 +61,31 @@ void load_graph_from_file(Graph& g, const string& filename) {
         return;
     }
 
-    string line;
-    int edge_count = 0;
+    long long duplicate_count = 0;
+    long long edge_count = read_edge_list(g, file, DEFAULT_PROBABILITY, &duplicate_count);
     
-    while (getline(file, line)) {
-        stringstream ss(line);
-        NodeID u, v;
-        if (ss >> u >> v) {
-            g.add_edge(u, v, DEFAULT_PROBABILITY);
-            edge_count++;
-        }
+    cout << "✓ Graph loaded: " << edge_count << " edges";
+    if (duplicate_count > 0) cout << " (" << duplicate_count << " duplicates skipped)";
+    cout << endl;
+}
+
+// Load straight into the packed adjacency, without building a Graph first
+CompressedGraph load_compressed_from_file(const string& filename) {
+    const double DEFAULT_PROBABILITY = 0.01;
+    ifstream file(filename);
+
+    long long edge_count = 0, duplicate_count = 0;
+    CompressedGraph g = CompressedGraph::build_from_edge_list(file, DEFAULT_PROBABILITY,
+                                                              &edge_count, &duplicate_count);
+    if (!file.is_open()) {
+        cerr << "Error: Could not open file " << filename << endl;
+        return g;
     }
-    
-    cout << "✓ Graph loaded: " << edge_count << " edges" << endl;
+
+    cout << "✓ Graph loaded: " << edge_count << " edges";
+    if (duplicate_count > 0) cout << " (" << duplicate_count << " duplicates skipped)";
+    cout << endl;
+    return g;
 }
 
 void print_header(const string& title) {
@@ -47,56 +102,193 @@ void show_menu() {
     cout << "  1. Find influential seeds (Betweenness Centrality)" << endl;
     cout << "  2. Run ICM influence spread simulation" << endl;
     cout << "  3. Compare BC vs Greedy seed selection" << endl;
+    cout << "  11. Find influential seeds (weighted BC over tie strength)" << endl;
+    cout << "  12. Instant spread queries (sketch influence oracle)" << endl;
     cout << "\nFRIEND RECOMMENDATION:" << endl;
     cout << "  4. Get friend recommendations for a user" << endl;
     cout << "  5. Find influential friend candidates (HYBRID)" << endl;
     cout << "  6. Analyze recommendation impact on influence spread" << endl;
+    cout << "  9. Fast friend recommendations (MinHash sketches)" << endl;
+    cout << "  10. Friend recommendations by personalized PageRank" << endl;
     cout << "\nGENERAL ANALYSIS:" << endl;
     cout << "  7. Show graph statistics" << endl;
     cout << "  8. Run complete demo (all features)" << endl;
+    cout << "  13. Show memory usage" << endl;
     cout << "  0. Exit" << endl;
     cout << string(80, '-') << endl;
     cout << "Enter choice: ";
 }
 
-void show_graph_stats(const Graph& g) {
+void print_ordering_metrics(const string& label, const OrderingMetrics& m) {
+    cout << "  " << left << setw(8) << label
+         << "avg gap: " << fixed << setprecision(2) << m.average_gap
+         << "  avg log2 gap: " << m.average_log_gap
+         << "  bandwidth: " << m.bandwidth << endl;
+}
+
+void reorder_graph(Graph& g, ReorderStrategy strategy) {
+    cout << "Reordering nodes (" << reorder_strategy_name(strategy) << ")..." << endl;
+    OrderingMetrics before = GraphReordering::compute_metrics(g);
+    auto start = chrono::high_resolution_clock::now();
+    g = GraphReordering::reorder(g, strategy);
+    auto end = chrono::high_resolution_clock::now();
+    OrderingMetrics after = GraphReordering::compute_metrics(g);
+
+    print_ordering_metrics("Before", before);
+    print_ordering_metrics("After", after);
+    cout << "  Time: " << chrono::duration_cast<chrono::milliseconds>(end - start).count()
+         << " ms" << endl;
+}
+
+template <typename GraphT>
+GraphProfile profile_graph(const GraphT& g) {
+    auto start = chrono::high_resolution_clock::now();
+    GraphProfile profile = GraphProfiler::profile(g);
+    auto end = chrono::high_resolution_clock::now();
+    cout << "✓ Profiled in " << chrono::duration_cast<chrono::milliseconds>(end - start).count()
+         << " ms: " << profile.num_components << " components, " << profile.triangles
+         << " triangles, diameter " << profile.diameter_lower;
+    if (!profile.diameter_exact()) cout << ".." << profile.diameter_upper;
+    cout << endl;
+    return profile;
+}
+
+// Profiles the loaded graph as its own phase and writes --profile-json if asked
+template <typename GraphT>
+GraphProfile profile_and_export(const GraphT& g, Session& session, const string& filename,
+                                const string& profile_path) {
+    GraphProfile profile;
+    {
+        PhaseTracker phase(session.phases, "Profile");
+        profile = profile_graph(g);
+    }
+    if (!profile_path.empty()) {
+        ofstream out(profile_path);
+        out << "{\"file\":\"" << filename << "\"," << profile.json_fields() << "}" << endl;
+        if (!out) cerr << "Error: Could not write " << profile_path << endl;
+    }
+    return profile;
+}
+
+void show_graph_stats(const GraphProfile& profile) {
     print_header("GRAPH STATISTICS");
-    const auto& adj = g.get_adj_list();
-    cout << "Total Nodes: " << adj.size() << endl;
-    
-    int total_edges = 0;
-    int max_degree = 0;
-    double sum_degree = 0;
-    
-    for (const auto& pair : adj) {
-        int degree = pair.second.size();
-        total_edges += degree;
-        max_degree = max(max_degree, degree);
-        sum_degree += degree;
+    cout << "Total Nodes: " << profile.num_nodes << endl;
+    cout << "Total Edges: " << profile.num_edges << endl;
+    cout << "Average Degree: " << fixed << setprecision(2) << profile.average_degree() << endl;
+    cout << "Max Degree: " << profile.max_degree << endl;
+    cout << "Degree (min / median / p90 / p99): " << profile.min_degree << " / " << profile.degree_p50
+         << " / " << profile.degree_p90 << " / " << profile.degree_p99 << endl;
+
+    cout << "\nConnected Components: " << profile.num_components
+         << " (largest has " << profile.largest_component_nodes << " nodes)" << endl;
+    cout << "Triangles: " << profile.triangles << endl;
+    cout << "Global Clustering: " << setprecision(4) << profile.global_clustering << endl;
+    cout << "Average Local Clustering: " << profile.average_clustering << endl;
+    cout << "Diameter (largest component): ";
+    if (profile.diameter_exact()) cout << profile.diameter_lower;
+    else cout << "between " << profile.diameter_lower << " and " << profile.diameter_upper;
+    cout << " (" << profile.diameter_bfs_count << " BFS runs)" << endl;
+
+    cout << "\nDegree Distribution:" << endl;
+    const size_t MAX_ROWS = 20;
+    size_t row = 0;
+    for (const auto& h : profile.degree_histogram) {
+        if (row++ == MAX_ROWS) {
+            cout << "  ... " << profile.degree_histogram.size() - MAX_ROWS << " more degrees" << endl;
+            break;
+        }
+        cout << "  " << setw(6) << h.first << ": " << h.second << endl;
     }
-    
-    total_edges /= 2;
-    cout << "Total Edges: " << total_edges << endl;
-    cout << "Average Degree: " << fixed << setprecision(2)
-         << (adj.size() > 0 ? sum_degree / adj.size() : 0.0) << endl;
-    cout << "Max Degree: " << max_degree << endl;
 }
 
-void run_complete_demo(const Graph& g) {
+void show_memory_usage(const Session& session, const MemoryReport& caches) {
+    print_header("MEMORY USAGE");
+    cout << "Graph structures:" << endl;
+    session.structures.print(cout);
+    if (!caches.entries.empty()) {
+        cout << "\nCaches:" << endl;
+        caches.print(cout);
+    }
+
+    cout << "\nProcess: " << fixed << setprecision(1) << ResidentMemory::current_bytes() / 1048576.0
+         << " MB resident";
+    if (HeapCounter::is_enabled()) cout << ", " << HeapCounter::live_bytes() / 1048576.0 << " MB heap";
+    cout << endl;
+    if (session.memory_budget_bytes > 0) {
+        cout << "Memory budget: " << setprecision(2) << session.memory_budget_bytes / 1048576.0
+             << " MB" << endl;
+        cout << setprecision(1);
+    }
+
+    cout << "\nPeak usage per phase:" << endl;
+    cout << "  " << left << setw(28) << "Phase" << right << setw(10) << "Time ms"
+         << setw(14) << "Heap peak MB" << setw(14) << "RSS peak MB" << left << endl;
+    for (const auto& phase : session.phases) {
+        cout << "  " << left << setw(28) << phase.name << right << setw(10) << phase.elapsed_ms
+             << setw(14) << phase.heap_peak_bytes / 1048576.0
+             << setw(14) << phase.rss_peak_bytes / 1048576.0 << left << endl;
+    }
+}
+
+// Budget left for an engine run after what the graph and caches already hold
+size_t engine_budget(const Session& session) {
+    size_t in_use = HeapCounter::is_enabled() ? HeapCounter::live_bytes() : session.structures.total();
+    return MemoryPlanner::remaining(session.memory_budget_bytes, in_use);
+}
+
+// The map based engine keeps four hash maps per source; when that does not fit the
+// budget, the CSR engine with unit lengths gives the same scores in far less memory
+template <typename GraphT>
+unordered_map<NodeID, double> betweenness_within_budget(const GraphT& g, const GraphProfile& profile,
+                                                        const Session& session) {
+    size_t n = profile.num_nodes;
+    size_t entries = 2 * profile.num_edges;
+    size_t budget = engine_budget(session);
+    if (MemoryPlanner::brandes_fits(n, entries, budget)) {
+        return BetweennessCentrality::compute_betweenness_centrality(g);
+    }
+    WeightedBCOptions options;
+    options.quantum = 1.0;
+    options.num_threads = MemoryPlanner::weighted_bc_threads(n, entries, budget, 0);
+    cout << "Memory budget: using the compact betweenness engine on " << options.num_threads
+         << " thread(s)" << endl;
+    return WeightedBetweennessCentrality::compute_betweenness_centrality(g, options, UnitDistance());
+}
+
+vector<NodeID> top_k_by_score(const unordered_map<NodeID, double>& bc, int k) {
+    vector<pair<double, NodeID>> arr;
+    for (const auto& p : bc) arr.push_back({p.second, p.first});
+    sort(arr.begin(), arr.end(),
+         [](const pair<double, NodeID>& a, const pair<double, NodeID>& b) { return a.first > b.first; });
+
+    vector<NodeID> res;
+    for (int i = 0; i < min(k, (int)arr.size()); i++) res.push_back(arr[i].second);
+    return res;
+}
+
+template <typename GraphT>
+vector<NodeID> top_betweenness_nodes(const GraphT& g, int k, const GraphProfile& profile,
+                                     const Session& session) {
+    return top_k_by_score(betweenness_within_budget(g, profile, session), k);
+}
+
+template <typename GraphT>
+void run_complete_demo(const GraphT& g, const GraphProfile& profile, const Session& session) {
     print_header("COMPLETE SYSTEM DEMONSTRATION");
     const int K_SEEDS = 5;
     const int NUM_SIMS = 1000;
     const auto& adj = g.get_adj_list();
     NodeID sample_user = adj.begin()->first;
+    NodeID sample_user_id = g.original_id(sample_user);
 
     cout << "\n[1/4] Finding influential seeds using Betweenness Centrality..." << endl;
     auto start = chrono::high_resolution_clock::now();
-    auto bc_seeds = BetweennessCentrality::get_top_k_nodes(g, K_SEEDS);
+    auto bc_seeds = top_betweenness_nodes(g, K_SEEDS, profile, session);
     auto end = chrono::high_resolution_clock::now();
     auto bc_time = chrono::duration_cast<chrono::milliseconds>(end - start).count();
     
     cout << "Top " << K_SEEDS << " seeds: ";
-    for (NodeID seed : bc_seeds) cout << seed << " ";
+    for (NodeID seed : bc_seeds) cout << g.original_id(seed) << " ";
     cout << "\nTime taken: " << bc_time << " ms" << endl;
 
     cout << "\n[2/4] Simulating influence spread with ICM..." << endl;
@@ -104,7 +296,7 @@ void run_complete_demo(const Graph& g) {
     int spread = InfluenceMaximization::simulate_ICM(g, seed_set, NUM_SIMS);
     cout << "Average spread: " << spread << " nodes influenced" << endl;
 
-    cout << "\n[3/4] Generating friend recommendations for User " << sample_user << "..." << endl;
+    cout << "\n[3/4] Generating friend recommendations for User " << sample_user_id << "..." << endl;
     auto recommendations = FriendRecommendation::get_recommendations(g, sample_user, 5);
     
     if (recommendations.empty()) {
@@ -114,7 +306,7 @@ void run_complete_demo(const Graph& g) {
              << setw(15) << "Jaccard" << setw(15) << "Adamic-Adar" << endl;
         cout << string(55, '-') << endl;
         for (const auto& rec : recommendations) {
-            cout << left << setw(10) << rec.candidate_id
+            cout << left << setw(10) << g.original_id(rec.candidate_id)
                  << setw(15) << rec.common_neighbors_count
                  << setw(15) << fixed << setprecision(4) << rec.jaccard_score
                  << setw(15) << fixed << setprecision(4) << rec.adamic_adar_score << endl;
@@ -129,7 +321,7 @@ void run_complete_demo(const Graph& g) {
     } else {
         cout << "Top 5 influential friend recommendations:" << endl;
         for (size_t i = 0; i < influential_friends.size(); ++i) {
-            cout << "  " << (i+1) << ". User " << influential_friends[i].first
+            cout << "  " << (i+1) << ". User " << g.original_id(influential_friends[i].first)
                  << " (hybrid score: " << fixed << setprecision(4)
                  << influential_friends[i].second << ")" << endl;
         }
@@ -145,26 +337,54 @@ void run_complete_demo(const Graph& g) {
     cout << "  • Hybrid analysis combining both approaches" << endl;
 }
 
-int main() {
-    Graph my_network;
-    const string filename = "../0.edges";
-    
-    print_header("INTEGRATED SOCIAL NETWORK SYSTEM");
-    cout << "Loading network data from " << filename << "..." << endl;
-    load_graph_from_file(my_network, filename);
-    
-    const auto& adj = my_network.get_adj_list();
-    if (adj.empty()) {
-        cerr << "Error: Graph is empty!" << endl;
-        return 1;
+// Reuses sketches saved next to the edge file if they were built for this graph
+template <typename GraphT>
+void prepare_oracle(const GraphT& g, InfluenceOracle& oracle, const string& sketch_path,
+                    const InfluenceOracleOptions& options) {
+    // a cache built with other settings, e.g. without the memory budget, is rebuilt
+    if (oracle.load(sketch_path) && oracle.matches(g)) {
+        if (oracle.built_with(options)) {
+            cout << "Loaded influence sketches from " << sketch_path << endl;
+            return;
+        }
+        cout << "Sketches in " << sketch_path << " use " << oracle.get_options().num_instances
+             << " instances with " << oracle.get_options().sketch_size << "-entry sketches; rebuilding" << endl;
     }
-    
+    cout << "Building influence sketches..." << endl;
+    auto start = chrono::high_resolution_clock::now();
+    oracle = InfluenceOracle::build(g, options);
+    auto end = chrono::high_resolution_clock::now();
+    cout << "Built in " << chrono::duration_cast<chrono::milliseconds>(end - start).count()
+         << " ms (" << fixed << setprecision(1) << oracle.memory_bytes() / 1024.0 << " KB)" << endl;
+    if (oracle.save(sketch_path)) {
+        cout << "Saved sketches to " << sketch_path << endl;
+    }
+}
+
+template <typename GraphT>
+void run_menu(const GraphT& g, const GraphProfile& profile, Session& session) {
+    const auto& adj = g.get_adj_list();
     cout << "System ready! Network has " << adj.size() << " users." << endl;
+
+    // built on first use of option 9
+    MinHashIndex sketch_index;
+    bool sketch_built = false;
+
+    // loaded or built on first use of option 12
+    InfluenceOracle oracle;
+    bool oracle_ready = false;
+
+    // built on first use of option 10, then reused with one workspace for every query
+    unique_ptr<PersonalizedPageRank> ppr;
+    PPRWorkspace ppr_workspace;
+
+    size_t num_entries = 2 * profile.num_edges;
     
     int choice;
     do {
         show_menu();
         cin >> choice;
+        if (cin.eof()) break;
         
         if (cin.fail()) {
             cin.clear();
@@ -182,14 +402,18 @@ int main() {
                 
                 cout << "\nCalculating betweenness centrality..." << endl;
                 auto start = chrono::high_resolution_clock::now();
-                auto seeds = BetweennessCentrality::get_top_k_nodes(my_network, k);
+                unordered_map<NodeID, double> bc_scores;
+                {
+                    PhaseTracker phase(session.phases, "Betweenness centrality");
+                    bc_scores = betweenness_within_budget(g, profile, session);
+                }
+                auto seeds = top_k_by_score(bc_scores, k);
                 auto end = chrono::high_resolution_clock::now();
                 auto duration = chrono::duration_cast<chrono::milliseconds>(end - start);
                 
                 cout << "\nTop " << k << " influential nodes:" << endl;
-                auto bc_scores = BetweennessCentrality::compute_betweenness_centrality(my_network);
                 for (size_t i = 0; i < seeds.size(); ++i) {
-                    cout << "  " << (i+1) << ". Node " << seeds[i]
+                    cout << "  " << (i+1) << ". Node " << g.original_id(seeds[i])
                          << " (BC score: " << fixed << setprecision(2)
                          << bc_scores[seeds[i]] << ")" << endl;
                 }
@@ -203,8 +427,9 @@ int main() {
                 set<NodeID> seeds;
                 NodeID seed;
                 while (cin >> seed && seed != -1) {
-                    if (adj.count(seed)) {
-                        seeds.insert(seed);
+                    NodeID node = g.internal_id(seed);
+                    if (adj.count(node)) {
+                        seeds.insert(node);
                     } else {
                         cout << "Warning: Node " << seed << " not in graph" << endl;
                     }
@@ -227,7 +452,11 @@ int main() {
                 
                 cout << "\nRunning ICM simulation..." << endl;
                 auto start = chrono::high_resolution_clock::now();
-                int spread = InfluenceMaximization::simulate_ICM(my_network, seeds, num_sims);
+                int spread;
+                {
+                    PhaseTracker phase(session.phases, "ICM simulation");
+                    spread = InfluenceMaximization::simulate_ICM(g, seeds, num_sims);
+                }
                 auto end = chrono::high_resolution_clock::now();
                 auto duration = chrono::duration_cast<chrono::milliseconds>(end - start);
                 
@@ -247,18 +476,19 @@ int main() {
                 int k;
                 cin >> k;
                 
+                PhaseTracker phase(session.phases, "BC vs greedy seeds");
                 cout << "\n[1/2] Betweenness Centrality method..." << endl;
-                auto bc_seeds = BetweennessCentrality::get_top_k_nodes(my_network, k);
+                auto bc_seeds = top_betweenness_nodes(g, k, profile, session);
                 set<NodeID> bc_set(bc_seeds.begin(), bc_seeds.end());
-                int bc_spread = InfluenceMaximization::simulate_ICM(my_network, bc_set, 500);
+                int bc_spread = InfluenceMaximization::simulate_ICM(g, bc_set, 500);
                 
                 cout << "BC Seeds: ";
-                for (NodeID s : bc_seeds) cout << s << " ";
+                for (NodeID s : bc_seeds) cout << g.original_id(s) << " ";
                 cout << "\nBC Spread: " << bc_spread << " nodes" << endl;
                 
                 cout << "\n[2/2] Greedy method (this may take a while)..." << endl;
-                auto greedy_set = InfluenceMaximization::greedy_seed_selection(my_network, k, 50);
-                int greedy_spread = InfluenceMaximization::simulate_ICM(my_network, greedy_set, 500);
+                auto greedy_set = InfluenceMaximization::greedy_seed_selection(g, k, 50);
+                int greedy_spread = InfluenceMaximization::simulate_ICM(g, greedy_set, 500);
                 
                 cout << "Greedy Spread: " << greedy_spread << " nodes" << endl;
                 cout << "\n--- Comparison ---" << endl;
@@ -273,6 +503,7 @@ int main() {
                 NodeID user;
                 cout << "Enter User ID: ";
                 cin >> user;
+                user = g.internal_id(user);
                 
                 if (!adj.count(user)) {
                     cout << "User not found!" << endl;
@@ -288,8 +519,8 @@ int main() {
                     cin.ignore(10000, '\n');
                 }
                 
-                auto recs = FriendRecommendation::get_recommendations(my_network, user, num_recs);
-                cout << "\nUser " << user << " has " << adj.at(user).size() << " friends" << endl;
+                auto recs = FriendRecommendation::get_recommendations(g, user, num_recs);
+                cout << "\nUser " << g.original_id(user) << " has " << g.get_neighbors(user).size() << " friends" << endl;
                 cout << "\nTop " << num_recs << " Recommendations:" << endl;
                 
                 if (recs.empty()) {
@@ -302,7 +533,7 @@ int main() {
                     
                     for (size_t i = 0; i < recs.size(); ++i) {
                         cout << left << setw(8) << (i+1)
-                             << setw(12) << recs[i].candidate_id
+                             << setw(12) << g.original_id(recs[i].candidate_id)
                              << setw(10) << recs[i].common_neighbors_count
                              << setw(12) << fixed << setprecision(4) << recs[i].jaccard_score
                              << setw(12) << fixed << setprecision(4) << recs[i].adamic_adar_score
@@ -318,6 +549,7 @@ int main() {
                 NodeID user;
                 cout << "Enter User ID: ";
                 cin >> user;
+                user = g.internal_id(user);
                 
                 if (!adj.count(user)) {
                     cout << "User not found!" << endl;
@@ -325,14 +557,14 @@ int main() {
                 }
                 
                 cout << "\nFinding influential users who would be good friends..." << endl;
-                auto influential = HybridAnalysis::find_influential_friend_candidates(my_network, user, 10);
+                auto influential = HybridAnalysis::find_influential_friend_candidates(g, user, 10);
                 
                 if (influential.empty()) {
                     cout << "No candidates found." << endl;
                 } else {
                     cout << "\nThese users are both similar to you AND influential in the network:" << endl;
                     for (size_t i = 0; i < influential.size(); ++i) {
-                        cout << "  " << (i+1) << ". User " << influential[i].first
+                        cout << "  " << (i+1) << ". User " << g.original_id(influential[i].first)
                              << " (hybrid score: " << fixed << setprecision(4)
                              << influential[i].second << ")" << endl;
                     }
@@ -345,6 +577,7 @@ int main() {
                 NodeID user;
                 cout << "Enter User ID: ";
                 cin >> user;
+                user = g.internal_id(user);
                 
                 if (!adj.count(user)) {
                     cout << "User not found!" << endl;
@@ -355,32 +588,239 @@ int main() {
                 set<NodeID> seeds;
                 NodeID seed;
                 while (cin >> seed && seed != -1) {
-                    if (adj.count(seed)) seeds.insert(seed);
+                    NodeID node = g.internal_id(seed);
+                    if (adj.count(node)) seeds.insert(node);
                 }
                 cin.clear();
                 
                 if (seeds.empty()) {
-                    auto bc_seeds = BetweennessCentrality::get_top_k_nodes(my_network, 3);
+                    auto bc_seeds = top_betweenness_nodes(g, 3, profile, session);
                     seeds = set<NodeID>(bc_seeds.begin(), bc_seeds.end());
                     cout << "Using default BC seeds: ";
-                    for (NodeID s : seeds) cout << s << " ";
+                    for (NodeID s : seeds) cout << g.original_id(s) << " ";
                     cout << endl;
                 }
                 
-                HybridAnalysis::analyze_recommendation_impact(my_network, user, seeds, 500);
+                HybridAnalysis::analyze_recommendation_impact(g, user, seeds, 500);
                 break;
             }
             
             case 7: {
-                show_graph_stats(my_network);
+                show_graph_stats(profile);
                 break;
             }
             
             case 8: {
-                run_complete_demo(my_network);
+                PhaseTracker phase(session.phases, "Complete demo");
+                run_complete_demo(g, profile, session);
+                break;
+            }
+
+            case 9: {
+                print_header("FAST FRIEND RECOMMENDATIONS (MINHASH/LSH)");
+                NodeID user;
+                cout << "Enter User ID: ";
+                cin >> user;
+                user = g.internal_id(user);
+
+                if (!adj.count(user)) {
+                    cout << "User not found!" << endl;
+                    break;
+                }
+
+                if (!sketch_built) {
+                    cout << "Building sketch index..." << endl;
+                    PhaseTracker phase(session.phases, "MinHash index build");
+                    auto start = chrono::high_resolution_clock::now();
+                    sketch_index.build(g);
+                    auto end = chrono::high_resolution_clock::now();
+                    cout << "Indexed " << sketch_index.size() << " users in "
+                         << chrono::duration_cast<chrono::milliseconds>(end - start).count()
+                         << " ms" << endl;
+                    sketch_built = true;
+                }
+
+                auto start = chrono::high_resolution_clock::now();
+                auto recs = SketchRecommendation::get_recommendations(g, sketch_index, user, 10);
+                auto end = chrono::high_resolution_clock::now();
+
+                if (recs.empty()) {
+                    cout << "No recommendations available." << endl;
+                } else {
+                    cout << left << setw(8) << "Rank" << setw(12) << "User ID"
+                         << setw(10) << "~Common" << setw(12) << "~Jaccard"
+                         << setw(12) << "Influence%" << endl;
+                    cout << string(54, '-') << endl;
+
+                    for (size_t i = 0; i < recs.size(); ++i) {
+                        cout << left << setw(8) << (i+1)
+                             << setw(12) << g.original_id(recs[i].candidate_id)
+                             << setw(10) << recs[i].common_neighbors_count
+                             << setw(12) << fixed << setprecision(4) << recs[i].jaccard_score
+                             << setw(12) << fixed << setprecision(1)
+                             << (recs[i].influence_potential * 100) << "%" << endl;
+                    }
+                }
+                cout << "\nQuery time: "
+                     << chrono::duration_cast<chrono::microseconds>(end - start).count()
+                     << " us" << endl;
                 break;
             }
             
+            case 10: {
+                print_header("PERSONALIZED PAGERANK RECOMMENDATIONS");
+                if (!ppr) {
+                    auto build_start = chrono::high_resolution_clock::now();
+                    ppr = make_unique<PersonalizedPageRank>(g);
+                    auto build_end = chrono::high_resolution_clock::now();
+                    cout << "Built PageRank adjacency in "
+                         << chrono::duration_cast<chrono::milliseconds>(build_end - build_start).count()
+                         << " ms" << endl;
+                }
+
+                NodeID user;
+                cout << "Enter User ID: ";
+                cin >> user;
+                user = g.internal_id(user);
+
+                if (!adj.count(user)) {
+                    cout << "User not found!" << endl;
+                    break;
+                }
+
+                auto start = chrono::high_resolution_clock::now();
+                auto recs = ppr->recommend(user, 10, ppr_workspace);
+                auto end = chrono::high_resolution_clock::now();
+
+                if (recs.empty()) {
+                    cout << "No recommendations available." << endl;
+                } else {
+                    cout << left << setw(8) << "Rank" << setw(12) << "User ID"
+                         << setw(12) << "PPR" << setw(10) << "Common"
+                         << setw(12) << "Jaccard" << setw(12) << "Adamic-Adar" << endl;
+                    cout << string(66, '-') << endl;
+
+                    for (size_t i = 0; i < recs.size(); ++i) {
+                        cout << left << setw(8) << (i+1)
+                             << setw(12) << g.original_id(recs[i].candidate_id)
+                             << setw(12) << fixed << setprecision(6) << recs[i].ppr_score
+                             << setw(10) << recs[i].common_neighbors_count
+                             << setw(12) << fixed << setprecision(4) << recs[i].jaccard_score
+                             << setw(12) << fixed << setprecision(4) << recs[i].adamic_adar_score << endl;
+                    }
+                }
+                cout << "\nQuery time: "
+                     << chrono::duration_cast<chrono::microseconds>(end - start).count()
+                     << " us" << endl;
+                break;
+            }
+
+            case 11: {
+                print_header("WEIGHTED BETWEENNESS CENTRALITY ANALYSIS");
+                int k;
+                cout << "Enter number of seeds (K): ";
+                cin >> k;
+
+                // path length is -log of the ICM influence probability of each tie
+                WeightedBCOptions options;
+                options.num_threads = MemoryPlanner::weighted_bc_threads(adj.size(), num_entries,
+                                                                         engine_budget(session), 0);
+                cout << "\nCalculating weighted betweenness centrality on " << options.num_threads
+                     << " thread(s)..." << endl;
+                auto start = chrono::high_resolution_clock::now();
+                unordered_map<NodeID, double> bc_scores;
+                {
+                    PhaseTracker phase(session.phases, "Weighted betweenness");
+                    bc_scores = WeightedBetweennessCentrality::compute_betweenness_centrality(
+                        g, options, InfluenceProbabilityDistance());
+                }
+                auto seeds = top_k_by_score(bc_scores, k);
+                auto end = chrono::high_resolution_clock::now();
+
+                cout << "\nTop " << k << " influential nodes:" << endl;
+                for (size_t i = 0; i < seeds.size(); ++i) {
+                    cout << "  " << (i+1) << ". Node " << g.original_id(seeds[i])
+                         << " (weighted BC score: " << fixed << setprecision(2)
+                         << bc_scores[seeds[i]] << ")" << endl;
+                }
+                cout << "\nTime: " << chrono::duration_cast<chrono::milliseconds>(end - start).count()
+                     << " ms" << endl;
+                break;
+            }
+
+            case 12: {
+                print_header("SKETCH INFLUENCE ORACLE");
+                if (!oracle_ready) {
+                    PhaseTracker phase(session.phases, "Influence sketches");
+                    InfluenceOracleOptions options = MemoryPlanner::oracle_options(
+                        adj.size(), num_entries, engine_budget(session));
+                    if (options.num_instances != InfluenceOracleOptions().num_instances ||
+                        options.sketch_size != InfluenceOracleOptions().sketch_size) {
+                        cout << "Memory budget: sampling " << options.num_instances
+                             << " instances with " << options.sketch_size << "-entry sketches" << endl;
+                    }
+                    prepare_oracle(g, oracle, session.sketch_path, options);
+                    oracle_ready = true;
+                }
+
+                cout << "Enter seed nodes (space-separated, -1 to end): ";
+                vector<NodeID> seeds;
+                NodeID seed;
+                while (cin >> seed && seed != -1) {
+                    NodeID node = g.internal_id(seed);
+                    if (adj.count(node)) {
+                        seeds.push_back(node);
+                    } else {
+                        cout << "Warning: Node " << seed << " not in graph" << endl;
+                    }
+                }
+                cin.clear();
+
+                if (!seeds.empty()) {
+                    auto start = chrono::high_resolution_clock::now();
+                    double spread = oracle.estimate_spread(seeds);
+                    auto end = chrono::high_resolution_clock::now();
+                    cout << "\nEstimated spread: " << fixed << setprecision(1) << spread
+                         << " nodes (" << (100.0 * spread / adj.size()) << "%)" << endl;
+                    cout << "Query time: "
+                         << chrono::duration_cast<chrono::microseconds>(end - start).count()
+                         << " us" << endl;
+                }
+
+                int k;
+                cout << "\nNumber of greedy seeds to pick from sketches (0 to skip): ";
+                cin >> k;
+                if (cin.fail()) {
+                    k = 0;
+                    cin.clear();
+                    cin.ignore(10000, '\n');
+                }
+                if (k > 0) {
+                    auto start = chrono::high_resolution_clock::now();
+                    auto greedy = oracle.greedy_seeds(k);
+                    auto end = chrono::high_resolution_clock::now();
+                    cout << "Greedy seeds: ";
+                    for (NodeID s : greedy) cout << g.original_id(s) << " ";
+                    cout << "\nEstimated spread: " << fixed << setprecision(1)
+                         << oracle.estimate_spread(greedy) << " nodes" << endl;
+                    cout << "Time: " << chrono::duration_cast<chrono::milliseconds>(end - start).count()
+                         << " ms" << endl;
+                }
+                break;
+            }
+
+            case 13: {
+                MemoryReport caches;
+                if (sketch_built) caches.add("MinHash index", sketch_index.memory_bytes());
+                if (oracle_ready) caches.add("Influence sketches", oracle.memory_bytes());
+                if (ppr) {
+                    caches.add("PageRank adjacency", ppr->memory_bytes());
+                    caches.add("PageRank workspace", ppr_workspace.memory_bytes());
+                }
+                show_memory_usage(session, caches);
+                break;
+            }
+
             case 0:
                 cout << "\nThank you for using the Integrated Social Network System!" << endl;
                 break;
@@ -390,6 +830,144 @@ int main() {
         }
         
     } while (choice != 0);
+}
+
+void print_usage(const char* program) {
+    cout << "Usage: " << program << " [edges_file] [--reorder none|degree|rcm|bfs|community] [--compressed]" << endl;
+    cout << "       " << string(strlen(program), ' ') << " [--profile-json file] [--memory-budget MB]" << endl;
+    cout << "       " << program << " --batch <dir|manifest> [--jobs N] [--output file] [--memory-budget MB]" << endl;
+}
+
+int run_batch(const string& source, const BatchOptions& options, const string& output_path) {
+    vector<BatchJob> jobs = BatchAnalysis::collect_jobs(source);
+    if (jobs.empty()) {
+        cerr << "Error: No edge files found in " << source << endl;
+        return 1;
+    }
+
+    ofstream file;
+    if (!output_path.empty()) {
+        file.open(output_path);
+        if (!file.is_open()) {
+            cerr << "Error: Could not open " << output_path << " for writing" << endl;
+            return 1;
+        }
+    }
+    ostream& out = output_path.empty() ? cout : file;
+
+    cerr << "Analyzing " << jobs.size() << " graphs..." << endl;
+    auto start = chrono::high_resolution_clock::now();
+    BatchSummary summary = BatchAnalysis::run(jobs, options, out, &cerr);
+    auto end = chrono::high_resolution_clock::now();
+
+    cerr << "Done: " << summary.succeeded << " analyzed, " << summary.failed << " failed in "
+         << chrono::duration_cast<chrono::milliseconds>(end - start).count() << " ms" << endl;
+    return summary.failed > 0 ? 2 : 0;
+}
+
+int main(int argc, char* argv[]) {
+    Graph my_network;
+    string filename = "../0.edges";
+    ReorderStrategy reorder_strategy = ReorderStrategy::NONE;
+    bool use_compressed = false;
+    string batch_source, output_path, profile_path;
+    BatchOptions batch_options;
+    Session session;
+#if defined(__GLIBC__)
+    HeapCounter::enable();
+#endif
+
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "--reorder" && i + 1 < argc) {
+            if (!parse_reorder_strategy(argv[++i], reorder_strategy)) {
+                cerr << "Error: Unknown reorder strategy " << argv[i] << endl;
+                print_usage(argv[0]);
+                return 1;
+            }
+        } else if (arg == "--compressed") {
+            use_compressed = true;
+        } else if (arg == "--profile-json" && i + 1 < argc) {
+            profile_path = argv[++i];
+        } else if (arg == "--batch" && i + 1 < argc) {
+            batch_source = argv[++i];
+        } else if (arg == "--jobs" && i + 1 < argc) {
+            batch_options.num_threads = atoi(argv[++i]);
+        } else if (arg == "--output" && i + 1 < argc) {
+            output_path = argv[++i];
+        } else if (arg == "--memory-budget" && i + 1 < argc) {
+            session.memory_budget_bytes = (size_t)(atof(argv[++i]) * 1024 * 1024);
+            batch_options.memory_budget_bytes = session.memory_budget_bytes;
+        } else if (arg == "--help" || arg == "-h") {
+            print_usage(argv[0]);
+            return 0;
+        } else if (!arg.empty() && arg[0] != '-') {
+            filename = arg;
+        } else {
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (!batch_source.empty()) {
+        return run_batch(batch_source, batch_options, output_path);
+    }
+    
+    print_header("INTEGRATED SOCIAL NETWORK SYSTEM");
+    cout << "Loading network data from " << filename << "..." << endl;
+    session.sketch_path = filename + ".sketch";
+
+    // Reordering works on a Graph, so only a plain --compressed run streams the file
+    if (use_compressed && reorder_strategy == ReorderStrategy::NONE) {
+        CompressedGraph compressed = [&]() {
+            PhaseTracker phase(session.phases, "Load");
+            return load_compressed_from_file(filename);
+        }();
+        if (compressed.get_adj_list().empty()) {
+            cerr << "Error: Graph is empty!" << endl;
+            return 1;
+        }
+        cout << "Compressed adjacency: " << fixed << setprecision(2)
+             << compressed.memory_bytes() / 1024.0 << " KB" << endl;
+        GraphProfile profile = profile_and_export(compressed, session, filename, profile_path);
+        session.structures = MemoryFootprint::graph(compressed);
+        run_menu(compressed, profile, session);
+        return 0;
+    }
+
+    {
+        PhaseTracker phase(session.phases, "Load");
+        load_graph_from_file(my_network, filename);
+    }
+    
+    if (my_network.get_adj_list().empty()) {
+        cerr << "Error: Graph is empty!" << endl;
+        return 1;
+    }
+
+    if (reorder_strategy != ReorderStrategy::NONE) {
+        PhaseTracker phase(session.phases, "Reorder");
+        reorder_graph(my_network, reorder_strategy);
+    }
+
+    GraphProfile profile = profile_and_export(my_network, session, filename, profile_path);
+    
+    if (use_compressed) {
+        CompressedGraph compressed = [&]() {
+            PhaseTracker phase(session.phases, "Compress");
+            return CompressedGraph(my_network);
+        }();
+        size_t graph_bytes = MemoryFootprint::graph(my_network).total();
+        my_network = Graph();
+        cout << "Compressed adjacency: " << fixed << setprecision(2)
+             << compressed.memory_bytes() / 1024.0 << " KB (was ~"
+             << graph_bytes / 1024.0 << " KB)" << endl;
+        session.structures = MemoryFootprint::graph(compressed);
+        run_menu(compressed, profile, session);
+    } else {
+        session.structures = MemoryFootprint::graph(my_network);
+        run_menu(my_network, profile, session);
+    }
     
     return 0;
 }
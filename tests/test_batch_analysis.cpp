@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include "batch_analysis.h"
+
+static double seed_spread(const string& line) {
+    const string key = "\"seed_spread\":";
+    size_t pos = line.find(key);
+    return pos == string::npos ? -1.0 : atof(line.c_str() + pos + key.size());
+}
+
+TEST(BatchAnalysisTest, AnalyzesManifestAndReportsFailures) {
+    string dir = ::testing::TempDir();
+    string star = dir + "batch_star.edges";
+    string path = dir + "batch_path.edges";
+    string manifest = dir + "batch_manifest.txt";
+
+    {
+        ofstream out(star);
+        for (int leaf = 2; leaf <= 9; ++leaf) out << "1 " << leaf << "\n";
+        out << "2 3\n";
+    }
+    {
+        ofstream out(path);
+        out << "10 11\n11 12\n";
+    }
+    {
+        ofstream out(manifest);
+        out << "# small graphs\n" << star << "\n\n" << path << "\n" << dir << "batch_missing.edges\n";
+    }
+
+    vector<BatchJob> jobs = BatchAnalysis::collect_jobs(manifest);
+    ASSERT_EQ(jobs.size(), 3);
+    EXPECT_EQ(jobs[0].path, star);   // largest first
+    EXPECT_EQ(jobs[2].file_bytes, 0);
+
+    BatchOptions options;
+    options.num_threads = 2;
+    options.top_k = 1;
+    options.memory_budget_bytes = 1;   // every job is over budget, so they run one at a time
+    ostringstream out;
+    BatchSummary summary = BatchAnalysis::run(jobs, options, out);
+
+    EXPECT_EQ(summary.succeeded, 2);
+    EXPECT_EQ(summary.failed, 1);
+    EXPECT_EQ(summary.peak_estimated_bytes, jobs[0].estimated_bytes);
+
+    vector<string> lines;
+    istringstream in(out.str());
+    for (string line; getline(in, line);) lines.push_back(line);
+    ASSERT_EQ(lines.size(), 3);
+
+    bool saw_star = false, saw_path = false;
+    for (const auto& line : lines) {
+        if (line.find(star) != string::npos) {
+            saw_star = true;
+            EXPECT_NE(line.find("\"nodes\":9,\"edges\":9"), string::npos);
+            EXPECT_NE(line.find("\"bc_top\":[1]"), string::npos);
+            // only the triangle 1-2-3 has ties with common neighbours (p = 0.1), so a
+            // single seed there activates about 1.2 nodes; the leaves have p = 0
+            double spread = seed_spread(line);
+            EXPECT_GE(spread, 1.0);
+            EXPECT_LE(spread, 1.6);
+            EXPECT_TRUE(line.find("\"seeds\":[1]") != string::npos ||
+                        line.find("\"seeds\":[2]") != string::npos ||
+                        line.find("\"seeds\":[3]") != string::npos);
+            EXPECT_NE(line.find("\"rec_user\":1"), string::npos);
+        } else if (line.find(path) != string::npos) {
+            saw_path = true;
+            EXPECT_NE(line.find("\"bc_top\":[11]"), string::npos);
+            EXPECT_NEAR(seed_spread(line), 1.0, 0.3);   // no common neighbours, p = 0
+        } else {
+            EXPECT_NE(line.find("\"error\":"), string::npos);
+        }
+    }
+    EXPECT_TRUE(saw_star);
+    EXPECT_TRUE(saw_path);
+
+    remove(star.c_str());
+    remove(path.c_str());
+    remove(manifest.c_str());
+}
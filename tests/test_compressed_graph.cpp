@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+#include "data_loader.h"
+#include "integrated_social_network.h"
+#include "compressed_graph.h"
+
+TEST(CompressedGraphTest, SameNeighborsAndResultsAsGraph) {
+    Graph g;
+    NodeID ids[] = {3, 17, 250, 70000, 16777300, 5, 9};
+    for (int i = 0; i < 7; ++i)
+        for (int j = i + 1; j < 7; ++j)
+            if ((i + j) % 3 != 0) g.add_edge(ids[i], ids[j], 0.25 * ((i + j) % 4));
+
+    CompressedGraph c(g);
+    ASSERT_EQ(c.get_adj_list().size(), g.get_adj_list().size());
+    for (const auto& p : g.get_adj_list()) {
+        vector<pair<NodeID, double>> expected, actual;
+        for (const auto& edge : p.second) expected.push_back({edge.target, edge.probability});
+        for (const auto& edge : c.get_neighbors(p.first)) actual.push_back({edge.target, edge.probability});
+        sort(expected.begin(), expected.end());
+        ASSERT_EQ(actual.size(), expected.size());
+        for (size_t i = 0; i < actual.size(); ++i) {
+            EXPECT_EQ(actual[i].first, expected[i].first);
+            EXPECT_NEAR(actual[i].second, expected[i].second, 1.0 / 255);
+        }
+    }
+    EXPECT_EQ(c.get_neighbors(42).size(), 0);
+
+    auto bc = BetweennessCentrality::compute_betweenness_centrality(g);
+    auto bc_c = BetweennessCentrality::compute_betweenness_centrality(c);
+    for (const auto& p : bc) EXPECT_NEAR(bc_c[p.first], p.second, 1e-9);
+
+    EXPECT_DOUBLE_EQ(FriendRecommendation::jaccard_coefficient(c, 3, 9),
+                     FriendRecommendation::jaccard_coefficient(g, 3, 9));
+}
+
+TEST(CompressedGraphTest, BuildsFromEdgeListWithoutGraph) {
+    string edges = "5 9\n9 5\n5 700000\n2 9\n2 2\n2 2\n\nnot an edge\n700000 2\n5 9\n";
+    Graph g;
+    istringstream graph_in(edges);
+    long long graph_duplicates = 0;
+    long long graph_edges = read_edge_list(g, graph_in, 0.3, &graph_duplicates);
+
+    istringstream in(edges);
+    long long count = 0, duplicates = 0;
+    CompressedGraph c = CompressedGraph::build_from_edge_list(in, 0.3, &count, &duplicates);
+    EXPECT_EQ(count, graph_edges);
+    EXPECT_EQ(duplicates, graph_duplicates);
+
+    ASSERT_EQ(c.get_adj_list().size(), g.get_adj_list().size());
+    for (const auto& p : g.get_adj_list()) {
+        vector<NodeID> expected, actual;
+        for (const auto& edge : p.second) expected.push_back(edge.target);
+        for (const auto& edge : c.get_neighbors(p.first)) {
+            actual.push_back(edge.target);
+            EXPECT_DOUBLE_EQ(edge.probability, 0.3);
+        }
+        sort(expected.begin(), expected.end());
+        EXPECT_EQ(actual, expected) << "node " << p.first;
+    }
+}
+
+TEST(CompressedGraphTest, DecoderMatchesScalarReference) {
+#if defined(SNA_EXPECT_SIMD)
+    EXPECT_TRUE(StreamVByte::uses_simd());   // the build enabled SSSE3, so this is the SIMD path
+#endif
+    // every control byte: lane lengths 1..4 from values just below each byte boundary
+    const uint32_t widths[4] = {0xFFu, 0xFFFFu, 0xFFFFFFu, 0xFFFFFFFFu};
+    for (int control = 0; control < 256; ++control) {
+        uint32_t group[4];
+        for (int lane = 0; lane < 4; ++lane) {
+            group[lane] = widths[(control >> (2 * lane)) & 3] - lane;
+        }
+        vector<uint8_t> bytes;
+        StreamVByte::encode_group(group, bytes);
+        ASSERT_EQ(bytes[0], control);
+        bytes.resize(bytes.size() + 16, 0);
+
+        uint32_t fast[4], reference[4];
+        int used = StreamVByte::decode_group(bytes.data(), 7, fast);
+        EXPECT_EQ(used, StreamVByte::decode_group_scalar(bytes.data(), 7, reference));
+        for (int lane = 0; lane < 4; ++lane) EXPECT_EQ(fast[lane], reference[lane]);
+    }
+}
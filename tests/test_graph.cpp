@@ -13,6 +13,11 @@ TEST(GraphTest, AddEdgeAndNeighbors) {
     auto n2 = g.get_neighbors(2);
     EXPECT_EQ(n2.size(), 2);
 
+    EXPECT_FALSE(g.add_edge(2, 1, 0.9));
+    EXPECT_EQ(g.get_neighbors(1).size(), 1);
+    EXPECT_TRUE(g.remove_edge(3, 2));
+    EXPECT_EQ(g.get_neighbors(3).size(), 0);
+
     auto n4 = g.get_neighbors(999);
     EXPECT_EQ(n4.size(), 0);
 }
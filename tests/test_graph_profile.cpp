@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+#include "data_loader.h"
+#include "graph_profile.h"
+
+TEST(GraphProfileTest, ProfilesComponentsTrianglesAndDiameter) {
+    // Component 1: a 4-clique 1-2-3-4 with a tail 4 - 5 - 6 - 7
+    // Component 2: the single edge 20 - 21
+    Graph g;
+    for (NodeID u = 1; u <= 4; ++u)
+        for (NodeID v = u + 1; v <= 4; ++v) g.add_edge(u, v, 0.1);
+    g.add_edge(4, 5, 0.1);
+    g.add_edge(5, 6, 0.1);
+    g.add_edge(6, 7, 0.1);
+    g.add_edge(20, 21, 0.1);
+
+    for (int threads : {1, 4}) {
+        GraphProfileOptions options;
+        options.num_threads = threads;
+        GraphProfile p = GraphProfiler::profile(g, options);
+
+        EXPECT_EQ(p.num_nodes, 9);
+        EXPECT_EQ(p.num_edges, 10);
+        EXPECT_EQ(p.min_degree, 1);
+        EXPECT_EQ(p.max_degree, 4);
+        EXPECT_EQ(p.degree_p50, 2);
+        EXPECT_EQ(p.degree_histogram.at(1), 3);
+
+        EXPECT_EQ(p.num_components, 2);
+        EXPECT_EQ(p.largest_component_nodes, 7);
+
+        // 4 triangles; triples: 3 nodes of degree 3, node 4 of degree 4, nodes 5 and 6 of degree 2
+        EXPECT_EQ(p.triangles, 4);
+        EXPECT_NEAR(p.global_clustering, 12.0 / (3 * 3 + 6 + 1 + 1), 1e-9);
+        EXPECT_NEAR(p.average_clustering, (3 * 1.0 + 0.5) / 9, 1e-9);
+
+        EXPECT_TRUE(p.diameter_exact());
+        EXPECT_EQ(p.diameter_lower, 4);
+    }
+}
+
+TEST(GraphProfileTest, ReportsBoundsWhenBFSBudgetRunsOut) {
+    // 100-cycle: every node has eccentricity 50, so the double sweep leaves the upper
+    // bound at 100 and iFUB needs many fringe BFS runs to close the gap
+    Graph g;
+    for (NodeID u = 0; u < 100; ++u) g.add_edge(u, (u + 1) % 100, 0.1);
+    GraphProfileOptions options;
+    options.max_diameter_bfs = 6;
+    GraphProfile p = GraphProfiler::profile(g, options);
+    EXPECT_FALSE(p.diameter_exact());
+    EXPECT_EQ(p.diameter_lower, 50);
+    EXPECT_LT(p.diameter_lower, p.diameter_upper);
+    EXPECT_LE(p.diameter_upper, 100);
+    EXPECT_LE(p.diameter_bfs_count, 6);
+
+    string json = p.to_json();
+    EXPECT_EQ(json.front(), '{');
+    EXPECT_NE(json.find("\"components\":1"), string::npos);
+    EXPECT_NE(json.find("\"diameter_lower\":50"), string::npos);
+    EXPECT_NE(json.find("\"diameter_upper\":" + to_string(p.diameter_upper)), string::npos);
+
+    // on a long path the double sweep alone is exact, whatever the budget
+    Graph path;
+    for (NodeID u = 0; u < 50; ++u) path.add_edge(u, u + 1, 0.1);
+    options.max_diameter_bfs = 3;
+    GraphProfile q = GraphProfiler::profile(path, options);
+    EXPECT_TRUE(q.diameter_exact());
+    EXPECT_EQ(q.diameter_lower, 50);
+    EXPECT_LE(q.diameter_bfs_count, 3);
+}
@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include "data_loader.h"
+#include "integrated_social_network.h"
+#include "influence_oracle.h"
+
+TEST(InfluenceOracleTest, EstimatesSpreadAndSurvivesSaveLoad) {
+    // 12-clique: every tie has 10 common neighbours, so p = 1 and any seed reaches all 12.
+    // The path 100 - 101 - 102 has no common neighbours, so p = 0.
+    Graph g;
+    for (NodeID u = 1; u <= 12; ++u)
+        for (NodeID v = u + 1; v <= 12; ++v) g.add_edge(u, v, 0.5);
+    g.add_edge(100, 101, 0.5);
+    g.add_edge(101, 102, 0.5);
+
+    InfluenceOracleOptions options;
+    options.num_instances = 16;
+    options.sketch_size = 64;
+    InfluenceOracle oracle = InfluenceOracle::build(g, options);
+
+    EXPECT_NEAR(oracle.estimate_spread({1}), 12.0, 3.0);
+    EXPECT_DOUBLE_EQ(oracle.estimate_spread({101}), 1.0);
+    EXPECT_DOUBLE_EQ(oracle.marginal_gain({1}, 2), 0.0);
+    EXPECT_DOUBLE_EQ(oracle.marginal_gain({101}, 100), 1.0);
+    EXPECT_GT(oracle.marginal_gain({101}, 1), 8.0);
+
+    auto seeds = oracle.greedy_seeds(2);
+    ASSERT_EQ(seeds.size(), 2);
+    EXPECT_LE(seeds[0], 12);
+    EXPECT_GE(seeds[1], 100);
+
+    string path = ::testing::TempDir() + "oracle_test.sketch";
+    ASSERT_TRUE(oracle.save(path));
+    InfluenceOracle loaded;
+    ASSERT_TRUE(loaded.load(path));
+    EXPECT_TRUE(loaded.matches(g));
+    EXPECT_TRUE(loaded.built_with(options));
+    EXPECT_FALSE(loaded.built_with(InfluenceOracleOptions()));
+    EXPECT_DOUBLE_EQ(loaded.estimate_spread({1, 100}), oracle.estimate_spread({1, 100}));
+    remove(path.c_str());
+
+    g.add_edge(102, 103, 0.5);
+    EXPECT_FALSE(loaded.matches(g));
+}
+
+TEST(InfluenceOracleTest, MatchesMonteCarloSpreadWithUnevenProbabilities) {
+    // 20-clique (p = 1 inside) with node 100 tied to four members at p = 0.3 and a
+    // tail 100 - 101 - 102 at p = 0. Clique sketches fill up early in the build, yet
+    // node 100 still reaches the clique in most instances.
+    Graph g;
+    for (NodeID u = 1; u <= 20; ++u)
+        for (NodeID v = u + 1; v <= 20; ++v) g.add_edge(u, v, 0.5);
+    for (NodeID v = 1; v <= 4; ++v) g.add_edge(100, v, 0.5);
+    g.add_edge(100, 101, 0.5);
+    g.add_edge(101, 102, 0.5);
+
+    InfluenceOracleOptions options;
+    options.num_instances = 512;
+    options.sketch_size = 256;
+    InfluenceOracle oracle = InfluenceOracle::build(g, options);
+
+    for (NodeID node : {100, 101, 1, 20}) {
+        double mc = InfluenceMaximization::simulate_ICM(g, {node}, 1000);
+        EXPECT_NEAR(oracle.estimate_spread({node}), mc, 0.2 * mc + 1.5) << "node " << node;
+    }
+}
+
+TEST(InfluenceOracleTest, RejectsTruncatedAndCorruptSketchFiles) {
+    Graph g;
+    for (NodeID u = 1; u <= 6; ++u) g.add_edge(u, u + 1, 0.5);
+    InfluenceOracle oracle = InfluenceOracle::build(g);
+    string path = ::testing::TempDir() + "oracle_corrupt.sketch";
+    ASSERT_TRUE(oracle.save(path));
+
+    string bytes;
+    {
+        ifstream in(path, ios::binary);
+        bytes.assign(istreambuf_iterator<char>(in), istreambuf_iterator<char>());
+    }
+    auto write = [&](const string& data) {
+        ofstream out(path, ios::binary | ios::trunc);
+        out.write(data.data(), data.size());
+    };
+    InfluenceOracle loaded;
+
+    write(bytes.substr(0, bytes.size() - 5));
+    EXPECT_FALSE(loaded.load(path));
+
+    string huge = bytes;
+    uint64_t count = 1ULL << 60;
+    memcpy(&huge[16], &count, sizeof(count));   // number of IDs
+    write(huge);
+    EXPECT_FALSE(loaded.load(path));
+
+    string bad_offset = bytes;
+    uint64_t offset = 1000;
+    size_t first_offset = 56 + 7 * sizeof(NodeID);
+    memcpy(&bad_offset[first_offset + sizeof(uint64_t)], &offset, sizeof(offset));
+    write(bad_offset);
+    EXPECT_FALSE(loaded.load(path));
+
+    write(bytes);
+    EXPECT_TRUE(loaded.load(path));
+    EXPECT_TRUE(loaded.matches(g));
+    remove(path.c_str());
+}
+
+TEST(InfluenceOracleTest, KeepsEstimatesWithinSeedsAndGraphSize) {
+    // Ring lattice (p = 0.2..0.4) plus an isolated p = 0 edge, whose nodes never
+    // fill their sketches; small sketches make the raw estimates noisy
+    Graph g;
+    const NodeID n = 300;
+    for (NodeID u = 0; u < n; ++u)
+        for (NodeID j = 1; j <= 3; ++j) g.add_edge(u, (u + j) % n, 0.5);
+    g.add_edge(1000, 1001, 0.5);
+
+    InfluenceOracleOptions options;
+    options.num_instances = 8;
+    options.sketch_size = 16;
+    InfluenceOracle oracle = InfluenceOracle::build(g, options);
+
+    vector<NodeID> all;
+    for (const auto& p : g.get_adj_list()) {
+        double spread = oracle.estimate_spread({p.first});
+        EXPECT_GE(spread, 1.0);
+        EXPECT_LE(spread, n + 2.0);
+        all.push_back(p.first);
+    }
+    EXPECT_DOUBLE_EQ(oracle.estimate_spread(all), n + 2.0);
+    EXPECT_DOUBLE_EQ(oracle.estimate_spread({1000, 1001, 1000}), 2.0);
+    EXPECT_DOUBLE_EQ(oracle.marginal_gain(all, 5), 0.0);
+}
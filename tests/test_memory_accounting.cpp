@@ -0,0 +1,56 @@
+#include <gtest/gtest.h>
+#include "data_loader.h"
+#include "graph_reordering.h"
+#include "memory_accounting.h"
+
+TEST(MemoryAccountingTest, ReportsStructuresAndPlansWithinBudget) {
+    Graph g;
+    for (NodeID u = 0; u < 200; ++u) g.add_edge(u, (u + 1) % 200, 0.1);
+
+    MemoryReport report = MemoryFootprint::graph(g);
+    ASSERT_EQ(report.entries.size(), 2);
+    EXPECT_EQ(report.entries[0].name, "Adjacency tree nodes");
+    EXPECT_GE(report.entries[1].bytes, 200 * 2 * sizeof(InfluenceEdge));
+    EXPECT_EQ(report.total(), report.entries[0].bytes + report.entries[1].bytes);
+
+    Graph relabeled = GraphReordering::reorder(g, ReorderStrategy::BFS);
+    EXPECT_EQ(MemoryFootprint::graph(relabeled).entries.size(), 3);   // plus the ID maps
+
+    size_t n = 200, entries = 400;
+    EXPECT_EQ(MemoryPlanner::weighted_bc_threads(n, entries, 0, 8), 8);
+    size_t two_threads = WeightedBetweennessCentrality::estimate_bytes(n, entries, 2);
+    EXPECT_EQ(MemoryPlanner::weighted_bc_threads(n, entries, two_threads, 8), 2);
+    EXPECT_EQ(MemoryPlanner::weighted_bc_threads(n, entries, 1, 8), 1);
+
+    EXPECT_EQ(MemoryPlanner::remaining(0, 1 << 20), 0);   // unlimited stays unlimited
+    EXPECT_EQ(MemoryPlanner::remaining(1000, 300), 700);
+    EXPECT_EQ(MemoryPlanner::remaining(1000, 5000), 1);
+    EXPECT_EQ(MemoryPlanner::weighted_bc_threads(n, entries, MemoryPlanner::remaining(two_threads, 1 << 20), 8), 1);
+
+    EXPECT_TRUE(MemoryPlanner::brandes_fits(n, entries, 0));
+    EXPECT_FALSE(MemoryPlanner::brandes_fits(n, entries, 1024));
+
+    InfluenceOracleOptions full;
+    InfluenceOracleOptions sampled = MemoryPlanner::oracle_options(n, entries, 100 * 1024);
+    EXPECT_LT(sampled.num_instances, full.num_instances);
+    EXPECT_LE(InfluenceOracle::estimate_build_bytes(n, entries, sampled), 100 * 1024);
+    InfluenceOracleOptions floor = MemoryPlanner::oracle_options(n, entries, 1);
+    EXPECT_EQ(floor.num_instances, 8);
+    EXPECT_EQ(floor.sketch_size, 16);
+}
+
+TEST(MemoryAccountingTest, TracksHeapPeakPerPhase) {
+    vector<PhaseUsage> phases;
+    {
+        PhaseTracker phase(phases, "Allocate");
+        HeapCounter::record_alloc(1 << 20);
+        HeapCounter::record_free(1 << 20);
+    }
+    {
+        PhaseTracker phase(phases, "Idle");
+    }
+    ASSERT_EQ(phases.size(), 2);
+    EXPECT_EQ(phases[0].name, "Allocate");
+    EXPECT_GE(phases[0].heap_peak_bytes, (size_t)1 << 20);
+    EXPECT_EQ(phases[1].heap_peak_bytes, 0);
+}
@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+#include "data_loader.h"
+#include "integrated_social_network.h"
+#include "minhash_index.h"
+#include "compressed_graph.h"
+#include "streaming_graph.h"
+
+TEST(MinHashTest, IncrementalMatchesBuildAndFindsTwinUsers) {
+    // 1 and 2 share friends 10..49 and have one private friend each
+    Graph g;
+    MinHashIndex incremental(128, 32);
+    auto add = [&](NodeID u, NodeID v) {
+        if (g.add_edge(u, v, 0.5)) incremental.add_edge(u, v);
+    };
+    for (NodeID f = 10; f < 50; ++f) {
+        add(1, f);
+        add(2, f);
+    }
+    add(1, 100);
+    add(2, 200);
+    add(100, 1);   // repeated edge and a self loop leave the degrees as built
+    add(2, 2);
+    for (NodeID f = 300; f < 340; ++f) add(3, f);
+
+    MinHashIndex built(128, 32);
+    built.build(g);
+    EXPECT_DOUBLE_EQ(built.estimate_jaccard(1, 2), incremental.estimate_jaccard(1, 2));
+    EXPECT_EQ(incremental.degree(1), 41);
+    EXPECT_EQ(incremental.degree(2), built.degree(2));
+    EXPECT_EQ(incremental.degree(100), 1);
+
+    double exact = FriendRecommendation::jaccard_coefficient(g, 1, 2);
+    EXPECT_NEAR(built.estimate_jaccard(1, 2), exact, 0.15);
+    EXPECT_LT(built.estimate_jaccard(1, 3), 0.1);
+
+    auto recs = SketchRecommendation::get_recommendations(g, built, 1, 5);
+    ASSERT_FALSE(recs.empty());
+    EXPECT_EQ(recs[0].candidate_id, 2);
+    EXPECT_NEAR(recs[0].common_neighbors_count, 40, 8);
+}
+
+TEST(MinHashTest, SkipsExistingFriendsOnCompressedGraph) {
+    // 1 and 2 are friends and share 10..29; 3 shares them too but is not a friend of 1
+    Graph g;
+    for (NodeID f = 10; f < 30; ++f) {
+        g.add_edge(1, f, 0.5);
+        g.add_edge(2, f, 0.5);
+        g.add_edge(3, f, 0.5);
+    }
+    g.add_edge(1, 2, 0.5);
+    CompressedGraph c(g);
+    EXPECT_TRUE(c.has_edge(1, 2));
+    EXPECT_TRUE(c.has_edge(29, 3));
+    EXPECT_FALSE(c.has_edge(1, 3));
+    EXPECT_FALSE(c.has_edge(1, 99));
+
+    MinHashIndex index(128, 32);
+    index.build(c);
+    auto recs = SketchRecommendation::get_recommendations(c, index, 1, 5);
+    ASSERT_FALSE(recs.empty());
+    EXPECT_EQ(recs[0].candidate_id, 3);
+    for (const auto& r : recs) EXPECT_NE(r.candidate_id, 2);
+}
+
+TEST(MinHashTest, FollowsStreamingBatches) {
+    StreamingGraph sg(8);
+    MinHashIndex incremental(128, 32);
+    vector<pair<NodeID, NodeID>> edges;
+    for (NodeID f = 10; f < 40; ++f) {
+        edges.push_back({1, f});
+        edges.push_back({2, f});
+    }
+    incremental.apply(*sg.snapshot(), sg.insert_edges(edges));
+
+    // 1 loses half its friends, gains 3 and re-adds 10 within the same batch
+    vector<EdgeUpdate> batch;
+    for (NodeID f = 10; f < 25; ++f) batch.push_back({EdgeUpdate::REMOVE, 1, f});
+    batch.push_back({EdgeUpdate::INSERT, 1, 3});
+    batch.push_back({EdgeUpdate::INSERT, 10, 1});
+    batch.push_back({EdgeUpdate::INSERT, 2, 50});
+    batch.push_back({EdgeUpdate::INSERT, 2, 50});
+    incremental.apply(*sg.snapshot(), sg.apply_batch(batch));
+
+    auto snapshot = sg.snapshot();
+    MinHashIndex built(128, 32);
+    built.build(*snapshot);
+    EXPECT_EQ(incremental.size(), built.size());
+    for (const auto& p : snapshot->get_adj_list()) {
+        EXPECT_EQ(incremental.degree(p.first), built.degree(p.first)) << "node " << p.first;
+    }
+    EXPECT_DOUBLE_EQ(incremental.estimate_jaccard(1, 2), built.estimate_jaccard(1, 2));
+    EXPECT_DOUBLE_EQ(incremental.estimate_jaccard(3, 2), built.estimate_jaccard(3, 2));
+    EXPECT_EQ(incremental.degree(1), 17);   // 25..39, 3 and 10
+}
@@ -0,0 +1,34 @@
+#include <gtest/gtest.h>
+#include "data_loader.h"
+#include "personalized_pagerank.h"
+
+TEST(PersonalizedPageRankTest, ReachesBeyondTwoHopsAndBatchMatches) {
+    // path 1 - 2 - 3 - 4 - 5
+    Graph g;
+    for (NodeID u = 1; u < 5; ++u) g.add_edge(u, u + 1, 0.5);
+
+    PersonalizedPageRank ppr(g, 0.15, 1e-6);
+    auto recs = ppr.recommend(1, 10);
+    ASSERT_EQ(recs.size(), 3);
+    EXPECT_EQ(recs[0].candidate_id, 3);
+    EXPECT_EQ(recs[0].common_neighbors_count, 1);
+    EXPECT_EQ(recs[1].candidate_id, 4);
+    EXPECT_EQ(recs[1].common_neighbors_count, 0);
+    EXPECT_GT(recs[0].ppr_score, recs[1].ppr_score);
+
+    PPRWorkspace ws;
+    double total = 0.0;
+    for (const auto& s : ppr.scores(1, ws)) total += s.second;
+    EXPECT_NEAR(total, 1.0, 1e-3);
+    EXPECT_GE(ws.memory_bytes(), ppr.workspace_bytes());
+    EXPECT_GE(ppr.memory_bytes(), 5 * sizeof(NodeID) + 8 * sizeof(int));
+
+    auto batch = ppr.recommend_batch({1, 5, 1}, 10, 2);
+    ASSERT_EQ(batch.size(), 3);
+    ASSERT_EQ(batch[2].size(), recs.size());
+    for (size_t i = 0; i < recs.size(); ++i) {
+        EXPECT_EQ(batch[2][i].candidate_id, recs[i].candidate_id);
+        EXPECT_DOUBLE_EQ(batch[2][i].ppr_score, recs[i].ppr_score);
+    }
+    EXPECT_EQ(batch[1][0].candidate_id, 3);
+}
@@ -0,0 +1,29 @@
+#include <gtest/gtest.h>
+#include "data_loader.h"
+#include "graph_reordering.h"
+
+TEST(ReorderingTest, RelabelKeepsEdgesAndOriginalIds) {
+    // path 40 - 10 - 30 - 20 - 50 with scattered IDs
+    Graph g;
+    g.add_edge(40, 10, 0.5);
+    g.add_edge(10, 30, 0.5);
+    g.add_edge(30, 20, 0.5);
+    g.add_edge(20, 50, 0.5);
+
+    Graph r = GraphReordering::reorder(g, ReorderStrategy::RCM);
+    ASSERT_EQ(r.get_adj_list().size(), 5);
+    EXPECT_EQ(GraphReordering::compute_metrics(r).bandwidth, 1);
+
+    for (const auto& p : g.get_adj_list()) {
+        NodeID u = r.internal_id(p.first);
+        ASSERT_NE(u, -1);
+        EXPECT_EQ(r.original_id(u), p.first);
+        ASSERT_EQ(r.get_neighbors(u).size(), p.second.size());
+        for (const auto& edge : r.get_neighbors(u)) {
+            bool found = false;
+            for (const auto& orig : p.second)
+                if (orig.target == r.original_id(edge.target)) found = true;
+            EXPECT_TRUE(found);
+        }
+    }
+}
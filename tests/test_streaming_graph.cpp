@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+#include "data_loader.h"
+#include "integrated_social_network.h"
+#include "streaming_graph.h"
+
+TEST(StreamingGraphTest, IncrementalCountsMatchRecomputeAndSnapshotsStayStable) {
+    StreamingGraph sg(8);
+    auto first = sg.insert_edges({{1, 2}, {2, 3}, {1, 3}, {3, 4}, {2, 1}, {5, 5}});
+    EXPECT_EQ(first.inserted.size(), 4);
+    EXPECT_EQ(first.ignored, 2);
+
+    auto v1 = sg.snapshot();
+    EXPECT_EQ(v1->common_neighbors(1, 2), 1);
+    EXPECT_DOUBLE_EQ(v1->get_neighbors(1)[0].probability, calculate_influence_probability(1));
+
+    sg.apply_batch({{EdgeUpdate::INSERT, 4, 1}, {EdgeUpdate::INSERT, 4, 2},
+                    {EdgeUpdate::REMOVE, 2, 3}, {EdgeUpdate::REMOVE, 7, 8}});
+    auto v2 = sg.snapshot();
+    EXPECT_EQ(v2->version(), v1->version() + 1);
+
+    // the old version is untouched
+    EXPECT_EQ(v1->statistics().num_edges, 4);
+    EXPECT_TRUE(v1->has_edge(2, 3));
+    EXPECT_FALSE(v1->has_edge(1, 4));
+
+    Graph g;
+    for (const auto& p : v2->get_adj_list())
+        for (const auto& edge : p.second) g.add_edge(p.first, edge.target, 0.0);
+    EXPECT_EQ(v2->statistics().num_edges, 5);
+    EXPECT_EQ(v2->statistics().num_nodes, (long long)g.get_adj_list().size());
+    EXPECT_EQ(v2->statistics().max_degree, 3);
+    for (const auto& p : g.get_adj_list())
+        for (const auto& edge : p.second)
+            EXPECT_EQ(v2->common_neighbors(p.first, edge.target),
+                      count_common_neighbors(g, p.first, edge.target));
+
+    auto bc = BetweennessCentrality::compute_betweenness_centrality(*v2);
+    auto expected = BetweennessCentrality::compute_betweenness_centrality(g);
+    for (const auto& p : expected) EXPECT_NEAR(bc[p.first], p.second, 1e-9);
+}
+
+TEST(StreamingGraphTest, BatchesCopyOnlyTheListsTheyChange) {
+    // 600 nodes on a ring with chords: far more than 8 blocks of 32 hold, so blocks grow
+    StreamingGraph sg(8);
+    vector<pair<NodeID, NodeID>> edges;
+    for (NodeID u = 0; u < 600; ++u) {
+        edges.push_back({u, (u + 1) % 600});
+        edges.push_back({u, (u + 2) % 600});
+    }
+    sg.insert_edges(edges);
+    auto before = sg.snapshot();
+    EXPECT_EQ(before->statistics().num_nodes, 600);
+    EXPECT_EQ(before->get_adj_list().size(), 600);
+    size_t listed = 0;
+    for (const auto& p : before->get_adj_list()) listed += p.second.size();
+    EXPECT_EQ(listed, 2 * 1200);
+
+    // inserting 100 - 300 has no common neighbours, so only those two lists change
+    sg.insert_edges({{100, 300}});
+    auto after = sg.snapshot();
+    EXPECT_NE(after->get_neighbors(100).data(), before->get_neighbors(100).data());
+    EXPECT_NE(after->get_neighbors(300).data(), before->get_neighbors(300).data());
+    EXPECT_EQ(after->get_neighbors(101).data(), before->get_neighbors(101).data());
+    EXPECT_EQ(after->get_neighbors(500).data(), before->get_neighbors(500).data());
+    EXPECT_EQ(before->get_neighbors(100).size(), 4);
+    EXPECT_EQ(after->get_neighbors(100).size(), 5);
+
+    // 0 - 3 shares 1 and 2, whose lists change with the counts; 4 stays shared
+    sg.insert_edges({{0, 3}});
+    auto third = sg.snapshot();
+    EXPECT_EQ(third->common_neighbors(0, 3), 2);
+    EXPECT_EQ(third->common_neighbors(1, 0), 3);   // 599, 2 and now 3
+    EXPECT_NE(third->get_neighbors(1).data(), after->get_neighbors(1).data());
+    EXPECT_EQ(third->get_neighbors(4).data(), after->get_neighbors(4).data());
+    EXPECT_EQ(after->common_neighbors(1, 0), 2);
+}
@@ -0,0 +1,32 @@
+#include <gtest/gtest.h>
+#include "data_loader.h"
+#include "integrated_social_network.h"
+#include "weighted_betweenness.h"
+
+TEST(WeightedBetweennessTest, MatchesUnweightedOnEqualWeightsAndAvoidsLongEdges) {
+    Graph g;
+    int edges[][2] = {{1,2},{2,3},{3,4},{4,1},{2,5},{5,6},{6,3},{4,7},{7,8},{1,8}};
+    for (auto& e : edges) g.add_edge(e[0], e[1], 0.5);
+
+    auto expected = BetweennessCentrality::compute_betweenness_centrality(g);
+    WeightedBCOptions real;
+    real.num_threads = 3;
+    WeightedBCOptions quantized;
+    quantized.quantum = 0.01;
+    auto bc_real = WeightedBetweennessCentrality::compute_betweenness_centrality(g, real);
+    auto bc_quantized = WeightedBetweennessCentrality::compute_betweenness_centrality(g, quantized);
+    for (const auto& p : expected) {
+        EXPECT_NEAR(bc_real[p.first], p.second, 1e-6);
+        EXPECT_NEAR(bc_quantized[p.first], p.second, 1e-6);
+    }
+
+    // the direct 1-3 tie is weak, so 1 -> 3 goes through 2
+    Graph w;
+    w.add_edge(1, 2, 0.9);
+    w.add_edge(2, 3, 0.9);
+    w.add_edge(1, 3, 0.1);
+    auto bc = WeightedBetweennessCentrality::compute_betweenness_centrality(w, quantized);
+    EXPECT_NEAR(bc[2], 1.0, 1e-9);
+    EXPECT_NEAR(bc[1], 0.0, 1e-9);
+    EXPECT_EQ(WeightedBetweennessCentrality::get_top_k_nodes(w, 1)[0], 2);
+}